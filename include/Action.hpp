@@ -1,17 +1,21 @@
 // Email: realyoavperetz@gmail.com
 #pragma once
 
-
+#include <array>
 #include <cstddef>
+#include <cstdint>
 
 namespace coup {
 
 class Player; // forward declaration
 
+/// Seat / player-id value meaning "nobody".
+inline constexpr std::uint8_t NO_SEAT = 0xFF;
+
 /**
  * Enum describing every distinct action that can be performed during the game.
  */
-enum class ActionType {
+enum class ActionType : std::uint8_t {
     Gather,
     Tax,
     Bribe,
@@ -21,9 +25,24 @@ enum class ActionType {
     Coup,
     Invest,
     BlockCoup,
-    BribeCancel
+    BribeCancel,
+    ArrestBlock,    ///< Spy::block_arrest (free, does not end the turn)
+    TaxUndo,        ///< Governor::undo of another player's tax
+    Pass            ///< decline a reaction, or forfeit a turn with no legal move
+};
+
+inline constexpr std::size_t ACTION_TYPE_COUNT = 13;
+
+/// Enumerator names, indexed by ActionType (the display log words some differently).
+inline constexpr std::array<const char*, ACTION_TYPE_COUNT> ACTION_NAMES = {
+    "Gather", "Tax", "Bribe", "Arrest", "Sanction", "TaxCancel", "Coup",
+    "Invest", "BlockCoup", "BribeCancel", "ArrestBlock", "TaxUndo", "Pass"
 };
 
+constexpr const char* action_name(ActionType t) noexcept {
+    return ACTION_NAMES[static_cast<std::size_t>(t)];
+}
+
 /**
  * Simple log entry used by Game to allow deferred blocking of actions.
  */
@@ -31,7 +50,19 @@ struct ActionRecord {
     Player*    actor      = nullptr;   ///< player who initiated the action
     ActionType type       = ActionType::Gather;
     Player*    target     = nullptr;   ///< may be nullptr if no target
-    std::size_t turn_idx  = 0;         ///< turn index when action happened
+    std::uint32_t turn    = 0;         ///< Game::turn_count() when it happened
+};
+
+/**
+ * One line of the display log, stored as 8 raw bytes. Names are only looked
+ * up (Game::format) when somebody actually wants to read the entry.
+ */
+struct LogEntry {
+    std::uint32_t turn    = 0;                  ///< Game::turn_count() at the time
+    std::uint8_t  actor   = NO_SEAT;            ///< player id, see Game::player_name()
+    std::uint8_t  target  = NO_SEAT;            ///< player id, NO_SEAT if untargeted
+    ActionType    type    = ActionType::Gather;
+    bool          success = true;
 };
 
 }
@@ -2,55 +2,273 @@
 #pragma once
 
 
+#include <array>
+#include <bit>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
 #include <cstddef>
-#include <unordered_set>
+#include <cstdint>
+#include <utility>
+#include <variant>
 
 #include "exceptions.hpp"
 #include "Action.hpp"       // defines ActionRecord, ActionType
-class Player;              // forward declaration
+#include "Move.hpp"         // defines Move, MoveList
+#include "Rules.hpp"        // defines RuleSet
+#include "roles/AnyRole.hpp" // defines AnyRole (and Player)
 
 namespace coup {
 
+/**
+ * Stable reference to a seat in one match. Unaffected by eliminations or
+ * turn-order changes; goes stale once the game is reset().
+ */
+struct SeatHandle {
+    std::uint8_t  seat  = NO_SEAT;
+    std::uint32_t epoch = 0;
+
+    friend bool operator==(const SeatHandle&, const SeatHandle&) = default;
+};
+
+/**
+ * Reaction window of the last blockable action. The action has already
+ * taken effect (Game keeps the deferred-undo model); the seats in
+ * `responders` may still answer it, lowest seat first:
+ *  - Tax   → other Governors may TaxUndo (the actor pays the tax back)
+ *  - Bribe → other Judges may BribeCancel (stays paid, no extra action)
+ *  - Coup  → Generals other than the actor with block_coup_cost coins,
+ *            the target included, may BlockCoup (the target comes back)
+ */
+struct Reaction {
+    ActionType   action     = ActionType::Pass;   ///< Tax, Bribe or Coup; Pass when closed
+    std::uint8_t actor      = NO_SEAT;
+    std::uint8_t target     = NO_SEAT;            ///< coup target, NO_SEAT otherwise
+    std::uint8_t responders = 0;                  ///< bit s = seat s has not answered yet
+
+    friend bool operator==(const Reaction&, const Reaction&) = default;
+};
+
 class Game {
+public:
+    static constexpr std::size_t MAX_PLAYERS = 6;
+
 private:
-    std::vector<Player*>        _players;
-    std::size_t                 _turn_idx = 0;
+    // Fixed seats: a player keeps its seat for the whole match. Eliminating
+    // only clears its alive bit (the pointer stays as a tombstone so a
+    // blocked coup can bring it back), and the turn moves to the next set bit.
+    std::array<Player*, MAX_PLAYERS> _seats{};
+    std::uint8_t                _alive     = 0;    ///< bit s set = seat s in play
+    std::uint8_t                _turn      = 0;    ///< seat to move
+    std::uint8_t                _prev_turn = 0;    ///< seat whose turn ended last
+    std::uint8_t                _seat_end  = 0;    ///< one past the highest seat taken
+    bool                        _start_pending = false;   ///< start_of_turn() waits for the open window
+    // playerObjects() view: alive players in seat order, rebuilt on demand
+    mutable std::vector<Player*> _players;
+    mutable bool                _players_dirty = false;
+    // players created by emplace_player(), stored in place by seat
+    std::array<std::optional<AnyRole>, MAX_PLAYERS> _owned;
     int                         _bank     = 0;
+    std::uint32_t               _turn_count = 0;   ///< completed next_turn() calls
+    std::uint32_t               _epoch = 0;        ///< bumped by reset()
+    RuleSet                     _rules;
+
+    // Deferred-blocking window: successful actions of the last few turns, one
+    // bucket per turn in a ring indexed by _turn_count. Starting a turn resets
+    // a single bucket, and the per-seat indexes below find records in O(1).
+    static constexpr std::size_t LOG_TURNS    = 8;    // > MAX_PLAYERS + 1
+    static constexpr std::size_t LOG_PER_TURN = 16;   // bribe + free blocks + reactions
+    struct TurnLog {
+        std::uint32_t turn = 0;
+        std::uint8_t  size = 0;
+        std::array<ActionRecord, LOG_PER_TURN> records{};
+    };
+    struct RecordRef {
+        std::uint32_t turn  = 0;
+        std::uint8_t  slot  = 0;
+        bool          valid = false;
+    };
+    std::array<TurnLog, LOG_TURNS>  _log{};
+    std::array<std::array<RecordRef, ACTION_TYPE_COUNT>, MAX_PLAYERS> _latest{};  ///< [actor seat][type]
+    std::array<RecordRef, MAX_PLAYERS> _coup_on{};                                  ///< [target seat]
+
+    ActionRecord* resolve(const RecordRef& ref) noexcept;
+    // display log: 8-byte records, names resolved only when formatted
+    std::vector<LogEntry>       _entries;
+    std::uint64_t               _log_base = 0;     ///< log_seq() of _entries[0]; reset() moves it on
+    std::vector<std::string>    _names;            ///< player id → name, join order
+    std::array<std::uint8_t, MAX_PLAYERS> _seat_ids{};   ///< seat → player id
+    bool                        _logging = true;
 
-    // existing blocking log
-    std::vector<ActionRecord>   _log;
-    // new formatted string log
-    std::vector<std::string>    _actionLogStrings;
+    // One-turn blocks packed per seat: bits [4s, 4s+4) belong to seat s, so
+    // clearing everything a player was blocked from is a single mask.
+    static constexpr std::uint32_t BLOCK_ARREST   = 1u << 0;
+    static constexpr std::uint32_t BLOCK_SANCTION = 1u << 1;
+    static constexpr std::uint32_t BLOCK_TAX      = 1u << 2;
+    static constexpr std::uint32_t BLOCK_BRIBE    = 1u << 3;
+    std::uint32_t               _blocks = 0;
+
+    Reaction                    _reaction;
+    void open_reaction(const Player* actor, ActionType type, const Player* target) noexcept;
+    ActionResult react(const Move& m);
+    /// Run the current player's start_of_turn() if next_turn() held it back.
+    void start_turn();
+
+    void set_block(const Player* p, std::uint32_t kind) noexcept;
+    bool has_block(const Player* p, std::uint32_t kind) const noexcept;
+    void clear_blocks(std::size_t seat) noexcept { _blocks &= ~(0xFu << (4 * seat)); }
+    std::uint8_t id_of(const Player* p) const noexcept;
+    /// Seat the next player joins, NO_SEAT when every seat was taken this match.
+    std::uint8_t free_seat() const noexcept;
+    /// First alive seat after `s`, wrapping around; `_alive` must be non-zero.
+    std::uint8_t next_alive(std::uint8_t s) const noexcept {
+        const unsigned later = _alive & ~((2u << s) - 1u);
+        return static_cast<std::uint8_t>(std::countr_zero(later ? later : unsigned{_alive}));
+    }
 
-    std::unordered_set<Player*> _arrest_blocked;
-    std::unordered_set<Player*> _sanction_blocked;
-    std::unordered_set<Player*> _tax_blocked;
-    std::unordered_set<Player*> _bribe_blocked;
+    template <class Self>
+    static auto owned_impl(Self& self, const Player* p) noexcept
+        -> decltype(&*self._owned[0]) {
+        if (!p || &p->_game != &self) return nullptr;
+        auto& slot = self._owned[p->_seat];
+        if (!slot) return nullptr;
+        const Player* base = std::visit([](const Player& r) { return &r; }, *slot);
+        return base == p ? &*slot : nullptr;
+    }
 public:
-    Game()                       = default;
+
+    /// Throws CoupException if `rules` is not usable (RuleSet::invalid()).
+    explicit Game(const RuleSet& rules = {});
     Game(const Game&)            = delete;
     Game& operator=(const Game&) = delete;
     ~Game()                      = default;
 
     // Player management
+    /**
+     * Seat p in the next seat never taken this match. Seats of eliminated
+     * players are not handed out again before reset(); throws CoupException
+     * once the table is full or all MAX_PLAYERS seats were used.
+     */
     void add_player(Player* p);
+    /**
+     * Create a player owned by this game, stored by value in its seat slot
+     * (no separate heap object). Lives until the game is destroyed or reset;
+     * an eliminated player keeps its seat and object for the rest of the match.
+     */
+    Player& emplace_player(RoleId role, const std::string& name);
+    template <class R>
+    R& emplace_player(const std::string& name) {
+        if (alive_count() >= _rules.max_players) {
+            COUP_THROW("Game is full");
+        }
+        const std::uint8_t seat = free_seat();
+        if (seat == NO_SEAT) {
+            COUP_THROW("Every seat of this match was taken");
+        }
+        // the constructor joins through add_player(), which picks this same seat
+        AnyRole& slot = _owned[seat].emplace(std::in_place_type<R>, *this, name);
+        return std::get<R>(slot);
+    }
+    /// Handle for p's seat in the current match (seat NO_SEAT if p is not in this game).
+    [[nodiscard]] SeatHandle handle(const Player& p) const noexcept;
+    /// Player in that seat, nullptr if the handle is stale or the seat is empty.
+    [[nodiscard]] Player* player(SeatHandle h) const noexcept;
+    /**
+     * Start a new match in this object: destroys owned players, forgets
+     * external ones, and clears turn, bank, blocks and both logs (log_seq()
+     * keeps counting). Vectors keep their capacity, so a recycled Game plays
+     * without reallocating. Outstanding SeatHandles go stale.
+     */
+    void reset() noexcept;
+    /// Number of the current match in this object; every reset() bumps it.
+    [[nodiscard]] std::uint32_t epoch() const noexcept { return _epoch; }
+
+    // Rules
+    [[nodiscard]] const RuleSet& rules() const noexcept { return _rules; }
+    /**
+     * Switch rules, e.g. between reset() matches of a sweep. Throws
+     * CoupException if `rules` is not usable or the table is over its cap.
+     */
+    void set_rules(const RuleSet& rules);
+
+    /// The in-place role object of an owned player, nullptr for external ones.
+    AnyRole*       owned(const Player* p) noexcept       { return owned_impl(*this, p); }
+    const AnyRole* owned(const Player* p) const noexcept { return owned_impl(*this, p); }
+    /**
+     * Call f on the concrete role object of an owned player (static dispatch
+     * through std::visit), or on the Player interface for external players.
+     */
+    template <class F>
+    decltype(auto) dispatch(Player& p, F&& f) {
+        if (AnyRole* r = owned(&p)) return std::visit(f, *r);
+        return f(p);
+    }
+    /// Take p out of play; O(1), no other seat moves.
     void eliminate(Player* p);
-    [[nodiscard]] const std::vector<Player*>& playerObjects() const noexcept {return _players;}
+    /// p holds a seat in this game and is still in play; O(1).
+    [[nodiscard]] bool has_player(const Player* p) const noexcept;
+    /// Players still in play, in seat (= turn) order.
+    [[nodiscard]] const std::vector<Player*>& playerObjects() const noexcept;
+    [[nodiscard]] std::size_t alive_count() const noexcept { return std::popcount(unsigned{_alive}); }
+    /// Bit s set = seat s still in play.
+    [[nodiscard]] std::uint8_t alive_mask() const noexcept { return _alive; }
+    /// Player in seat s, eliminated ones included; nullptr for a seat never taken.
+    [[nodiscard]] Player* at_seat(std::size_t s) const noexcept {
+        return s < MAX_PLAYERS ? _seats[s] : nullptr;
+    }
+    /// One past the highest seat taken this match (Move seats are below it).
+    [[nodiscard]] std::size_t seat_count() const noexcept { return _seat_end; }
 
     // Turn control
     [[nodiscard]] std::string turn() const;
     [[nodiscard]] std::vector<std::string> players() const;
     void next_turn();
     void validate_turn(const Player* p) const;
-    Player* current_player() const { return _players.empty() ? nullptr : _players[_turn_idx]; }
+    /// Non-throwing form of validate_turn().
+    [[nodiscard]] ActionResult check_turn(const Player* p) const noexcept;
+    Player* current_player() const { return _alive ? _seats[_turn] : nullptr; }
+    /// Number of turns completed so far (never wraps back with eliminations).
+    [[nodiscard]] std::uint32_t turn_count() const noexcept { return _turn_count; }
+
+    // Move generation
+    /**
+     * Fill `out` with every action the current player may take right now,
+     * applying exactly the checks of the Player / role try_* methods, or
+     * with reaction_moves() while a reaction window is open.
+     * Never allocates; out is cleared first.
+     */
+    void legal_moves(MoveList& out) const;
+    /// Same as above; reuses the caller's vector capacity.
+    void legal_moves(std::vector<Move>& out) const;
+    /**
+     * Execute a move produced by legal_moves() through the try_* API, or a
+     * reaction_moves() answer to the open reaction window.
+     */
+    ActionResult play(const Move& m);
+
+    // Reaction window
+    /**
+     * Window opened by the last successful Tax, Bribe or Coup. It closes
+     * once every responder answered through play(); until then every turn
+     * action (and a Spy's free arrest block) fails with NotYourTurn.
+     */
+    [[nodiscard]] const Reaction& reaction() const noexcept { return _reaction; }
+    [[nodiscard]] bool in_reaction() const noexcept { return _reaction.responders != 0; }
+    /// Seat that answers next (the lowest responder), NO_SEAT when closed.
+    [[nodiscard]] std::uint8_t responder() const noexcept {
+        return in_reaction() ? static_cast<std::uint8_t>(std::countr_zero(unsigned{_reaction.responders}))
+                             : NO_SEAT;
+    }
+    /// The responder's answers: its reaction, then Pass. Empty when closed.
+    void reaction_moves(MoveList& out) const noexcept;
 
     // Winner
     [[nodiscard]] std::string winner() const;
 
     // Bank
     [[nodiscard]] int& bank() noexcept { return _bank; }
+    [[nodiscard]] int  bank() const noexcept { return _bank; }
 
     // Action log
     /**
@@ -66,30 +284,72 @@ public:
                          bool success = true);
                          
     void block_tax(Player* target);
-    bool is_tax_blocked(Player* p) const noexcept;
+    bool is_tax_blocked(const Player* p) const noexcept;
     void block_bribe(Player* target);
-    bool is_bribe_blocked(Player* p) const noexcept;
+    bool is_bribe_blocked(const Player* p) const noexcept;
+
+    /**
+     * Display log switch. Off, register_action() still feeds the blocking
+     * log the rules need but records nothing for display (headless runs).
+     */
+    void set_logging(bool on) noexcept { _logging = on; }
+    [[nodiscard]] bool logging() const noexcept { return _logging; }
+
+    /// Raw display log, oldest first.
+    [[nodiscard]] const std::vector<LogEntry>& log_entries() const noexcept { return _entries; }
+    /**
+     * Sequence number of the next entry; grows by one per logged action and
+     * never goes back, not even across reset(), so a reader can remember it
+     * and ask what is new.
+     */
+    [[nodiscard]] std::uint64_t log_seq() const noexcept { return _log_base + _entries.size(); }
+    /// Sequence number of this match's first entry (log_seq() right after reset()).
+    [[nodiscard]] std::uint64_t log_start() const noexcept { return _log_base; }
+    /// The last `n` entries (fewer if the log is shorter), oldest first.
+    /// No copy; the view is valid until the next register_action().
+    [[nodiscard]] std::span<const LogEntry> log_tail(std::size_t n) const noexcept;
+    /**
+     * Entries logged since `seq` (an earlier log_seq() value), oldest first.
+     * A seq from before the last reset() yields this whole match's log: the
+     * entries of earlier matches are gone.
+     */
+    [[nodiscard]] std::span<const LogEntry> log_since(std::uint64_t seq) const noexcept;
+    /// Name of a LogEntry player id; valid even after the player left.
+    [[nodiscard]] const std::string& player_name(std::uint8_t id) const;
+    /// LogEntry player id of the player in seat s (NO_SEAT for a seat never taken).
+    [[nodiscard]] std::uint8_t player_id(std::size_t s) const noexcept {
+        return at_seat(s) ? _seat_ids[s] : NO_SEAT;
+    }
+    /// "playerName,Action[ for target],Succeeded|Failed"
+    [[nodiscard]] std::string format(const LogEntry& e) const;
 
     /**
      * Returns the formatted log entries:
      * "playerName,Action,Succeeded" or "playerName,Action,Failed".
+     * Formats the whole log on every call.
      */
-    [[nodiscard]] std::vector<std::string> getActionLog() const noexcept {
-        return _actionLogStrings;
-    }
+    [[nodiscard]] std::vector<std::string> getActionLog() const;
 
+    /// Most recent successful `type` by actor within the blocking window, or nullptr.
     ActionRecord* last_action(Player* actor, ActionType type);
+    /// Start the bucket of the current turn; O(1). Called by next_turn().
     void prune_log();
 
     // Blocks
     void block_arrest(Player* target);
-    bool is_arrest_blocked(Player* p) const;
+    bool is_arrest_blocked(const Player* p) const noexcept;
 
     void block_sanction(Player* target);
-    bool is_sanctioned(Player* p) const;
+    bool is_sanctioned(const Player* p) const noexcept;
 
     // Coup undo
+    /**
+     * Undo the latest coup on target and put it back in its own seat. If the
+     * turn already passed that seat, the restored player moves next.
+     */
     void cancel_coup(Player* target);
+    /// Most recent coup against target still in the log, or nullptr.
+    ActionRecord* last_coup(Player* target);
 
     void clear_sanction(Player* p);
 };
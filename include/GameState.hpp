@@ -0,0 +1,154 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Move.hpp"
+#include "Role.hpp"
+#include "Rules.hpp"
+
+namespace coup {
+
+class Game;
+
+/**
+ * @brief Flat, trivially copyable snapshot of a game for search and rollouts.
+ *
+ * `Rules` is a policy with a static `RuleSet rules` member. StandardRules
+ * makes every cost, limit and enabled role a compile-time constant, so the
+ * engine is specialised for the standard game (that is coup::GameState);
+ * RuntimeRules reads them from a mutable RuleSet instead.
+ *
+ * Seats are fixed (eliminated players keep their index), every one-turn
+ * block is a bitmask over seats, and the whole state fits in one cache line,
+ * so copying and comparing it is cheap. `key` is a Zobrist hash that every
+ * change updates in place, so hash() costs nothing.
+ *
+ * Rules mirror Player / role try_* exactly, with one addition: blockable
+ * actions open a reaction window instead of relying on deferred undo.
+ *  - Tax   → other Governors may TaxUndo (actor loses 2)
+ *  - Bribe → other Judges may BribeCancel (4 coins lost, no extra action)
+ *  - Coup  → Generals with 5+ coins may BlockCoup (target survives)
+ * While a window is open, the lowest responder seat decides between its
+ * reaction and Pass; once everybody passed the action resolves normally.
+ */
+template <class Rules>
+struct BasicGameState {
+    static constexpr std::size_t MAX_SEATS = 6;
+
+    // Per-seat data
+    std::array<RoleId, MAX_SEATS>       role{};
+    std::array<std::uint8_t, MAX_SEATS> coins{};          ///< saturates at 255
+    std::array<std::uint8_t, MAX_SEATS> last_arrest{NO_SEAT, NO_SEAT, NO_SEAT,
+                                                    NO_SEAT, NO_SEAT, NO_SEAT}; ///< NO_SEAT if none
+
+    // Table
+    std::uint8_t seats          = 0;   ///< seats in use
+    std::uint8_t alive          = 0;   ///< bit i set = seat i still playing
+    std::uint8_t turn           = 0;   ///< seat whose turn it is
+    std::uint8_t extra_action   = 0;   ///< 1 after a successful bribe
+
+    // One-turn blocks, bit i = seat i
+    std::uint8_t arrest_blocked = 0;
+    std::uint8_t sanctioned     = 0;
+    std::uint8_t tax_blocked    = 0;
+    std::uint8_t bribe_blocked  = 0;
+
+    // Reaction window (open while responders != 0)
+    ActionType   pending        = ActionType::Pass;
+    std::uint8_t pending_actor  = NO_SEAT;
+    std::uint8_t pending_target = NO_SEAT;
+    std::uint8_t responders     = 0;
+
+    std::int16_t bank           = 0;
+
+    /**
+     * Zobrist key of every field above, XOR-ed in per (field, value) as the
+     * field changes; coins from 31 up share one key. The values of a
+     * default-constructed state contribute 0. Debug builds (no NDEBUG)
+     * check it against zobrist() after each apply() and undo(). Code that
+     * writes fields directly must call rehash() afterwards.
+     */
+    std::uint64_t key           = 0;
+
+    /// Saved state for undo(); the state is small enough to restore wholesale.
+    struct Undo;
+
+    // Construction: start from `BasicGameState{}` and add_seat() once per
+    // player; seats past Rules::rules.max_players are ignored
+    void add_seat(RoleId r, int coins = 0) noexcept;
+    /**
+     * Snapshot of a live game; seat i is Game::at_seat(i), eliminated seats
+     * stay dead. Game's reaction window is not copied: there the action has
+     * already resolved, so the snapshot is the state after everybody passed.
+     */
+    static BasicGameState from(const Game& game);
+
+    // Queries
+    bool is_alive(std::size_t s)    const noexcept { return alive >> s & 1u; }
+    bool in_reaction()              const noexcept { return responders != 0; }
+    int  alive_count()              const noexcept;
+    bool is_terminal()              const noexcept { return alive_count() <= 1; }
+    /// Seat that must choose the next move (responder during a window).
+    std::uint8_t to_move()          const noexcept;
+    /// Last seat standing, NO_SEAT while the game is running.
+    std::uint8_t winner()           const noexcept;
+
+    /// Every legal move for to_move(); empty only when the game is over.
+    void legal_moves(MoveList& out) const noexcept;
+    /// Apply a legal move; returns what undo() needs to restore this state.
+    Undo apply(const Move& m) noexcept;
+    /// Revert `m`, given the record returned when it was applied.
+    void undo(const Move& m, const Undo& u) noexcept;
+
+    /// The Zobrist key; O(1).
+    std::uint64_t hash() const noexcept { return key; }
+    /// Recompute the key from every field (what `key` must always equal).
+    std::uint64_t zobrist() const noexcept;
+    /// Set `key` from scratch after writing fields directly.
+    void rehash() noexcept { key = zobrist(); }
+    friend bool operator==(const BasicGameState&, const BasicGameState&) = default;
+
+private:
+    static constexpr std::uint8_t bit(std::size_t s) noexcept {
+        return static_cast<std::uint8_t>(1u << s);
+    }
+    static constexpr bool has_role(RoleId r) noexcept { return Rules::rules.has_role(r); }
+    bool must_coup(std::size_t s) const noexcept { return coins[s] >= Rules::rules.coup_limit; }
+    // Every write below goes through these, which keep `key` current
+    void gain(std::size_t s, int n) noexcept;
+    void add_bank(int n) noexcept;
+    void flip(std::uint8_t& mask, std::uint8_t bits, std::size_t which) noexcept;
+    void set_extra(std::uint8_t on) noexcept;
+    void set_turn(std::uint8_t s) noexcept;
+    void set_last_arrest(std::size_t s, std::uint8_t target) noexcept;
+    void open_window(ActionType type, std::uint8_t actor, std::uint8_t target,
+                     std::uint8_t who) noexcept;
+    void resolve(bool blocked, std::uint8_t by) noexcept;
+    void finish_action() noexcept;
+    void next_turn() noexcept;
+};
+
+template <class Rules>
+struct BasicGameState<Rules>::Undo {
+    BasicGameState saved;
+};
+
+/// The standard game, every rule a constant.
+using GameState        = BasicGameState<StandardRules>;
+/// Same engine reading RuntimeRules::rules on each use (sweeps, benchmarks).
+using RuntimeGameState = BasicGameState<RuntimeRules>;
+
+// defined in GameState.cpp
+extern template struct BasicGameState<StandardRules>;
+extern template struct BasicGameState<RuntimeRules>;
+
+static_assert(std::is_trivially_copyable_v<GameState>);
+static_assert(std::has_unique_object_representations_v<GameState>,
+              "GameState should have no padding bytes");
+static_assert(sizeof(GameState) <= 64, "GameState should fit one cache line");
+
+} // namespace coup
@@ -0,0 +1,48 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Action.hpp"
+
+namespace coup {
+
+/**
+ * One legal action, as produced by Game::legal_moves() and consumed by
+ * Game::play(). Seats are Player::seat() values, fixed for the whole
+ * match, so a move stays valid across eliminations elsewhere at the table.
+ */
+struct Move {
+    ActionType   type   = ActionType::Gather;
+    std::uint8_t actor  = NO_SEAT;   ///< seat performing the action
+    std::uint8_t target = NO_SEAT;   ///< target seat, NO_SEAT if untargeted
+
+    friend bool operator==(const Move&, const Move&) = default;
+};
+
+/**
+ * Fixed-capacity move buffer: no heap allocation, large enough for every
+ * move a single seat can have (4 untargeted + 4 targeted × 5 opponents).
+ */
+class MoveList {
+public:
+    static constexpr std::size_t CAPACITY = 32;
+
+    void        clear()                    noexcept { _size = 0; }
+    void        push_back(const Move& m)   noexcept { _moves[_size++] = m; }
+    std::size_t size()               const noexcept { return _size; }
+    bool        empty()              const noexcept { return _size == 0; }
+
+    const Move& operator[](std::size_t i) const noexcept { return _moves[i]; }
+    const Move* begin() const noexcept { return _moves.data(); }
+    const Move* end()   const noexcept { return _moves.data() + _size; }
+
+private:
+    std::array<Move, CAPACITY> _moves{};
+    std::size_t                _size = 0;
+};
+
+} // namespace coup
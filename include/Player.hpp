@@ -2,9 +2,11 @@
 #pragma once
 
 
+#include <cstdint>
 #include <string>
 #include "exceptions.hpp"
 #include "Action.hpp"
+#include "Role.hpp"
 
 namespace coup {
 
@@ -12,16 +14,34 @@ class Game;  // forward declaration
 
 class Player {
 public:
-    Player(Game& game, const std::string& name);
+    Player(Game& game, const std::string& name, RoleId role);
     virtual ~Player() = default;
-    // Actions
-    virtual void gather();
-    virtual void tax();
-    virtual void bribe();
-    virtual void arrest(Player& target);
-    virtual void sanction(Player& target);
-    virtual void coup(Player& target);
-    virtual void undo(Player& action_owner);
+    // Actions (throw CoupException and log a failed attempt when illegal)
+    void gather();
+    void tax();
+    void bribe();
+    void arrest(Player& target);
+    void sanction(Player& target);
+    void coup(Player& target);
+    void undo(Player& action_owner);
+
+    // Non-throwing actions: ActionResult::Ok on success, otherwise the rule
+    // that rejected the move. Nothing is changed or logged on failure.
+    virtual ActionResult try_gather();
+    virtual ActionResult try_tax();
+    virtual ActionResult try_bribe();
+    virtual ActionResult try_arrest(Player& target);
+    virtual ActionResult try_sanction(Player& target);
+    virtual ActionResult try_coup(Player& target);
+    virtual ActionResult try_undo(Player& action_owner);
+
+    // Rule checks behind try_* (and Game::legal_moves): Ok if legal right now.
+    ActionResult can_gather() const noexcept;
+    ActionResult can_tax() const noexcept;
+    ActionResult can_bribe() const noexcept;
+    ActionResult can_arrest(const Player& target) const noexcept;
+    ActionResult can_sanction(const Player& target) const noexcept;
+    ActionResult can_coup(const Player& target) const noexcept;
 
     // Reaction hooks (public so Game can call them)
     virtual void on_sanction([[maybe_unused]] Player& attacker) {}
@@ -31,27 +51,41 @@ public:
     // Info
     const std::string& name()  const noexcept { return _name; }
     int                 coins() const noexcept { return _coins; }
+    const Player*       last_arrest_target() const noexcept { return _lastArrestTarget; }
+    bool                has_extra_action()   const noexcept { return _extraActionAllowed; }
+    /// Seat index in the game (0..5), fixed while the player is in it.
+    std::uint8_t        seat()  const noexcept { return _seat; }
 
     // Utility
     void spend(int amount);
     void gain(int amount) noexcept;
 
-    // override your existing role() to return this
-    virtual std::string role() const { return _roleName;}
+    // Role: rules branch on role_id(); role() is the display name
+    RoleId      role_id() const noexcept { return _role; }
+    std::string role()    const { return role_name(_role); }
+
+    void change_role(RoleId newRole) noexcept { _role = newRole; }
+    /// Same, by display name; throws CoupException for an unknown name.
+    void change_role(const std::string& newRole);
 
-    void change_role(const std::string& newRole) {
-        _roleName = newRole;
-    }
-    
 protected:
+    friend class Game;        // Game assigns seats and clears per-turn state
+
     std::string _name;
     int         _coins = 0;
     Game&       _game;
-    std::string _roleName;    // store the current role name
+    RoleId      _role;        // current role (role() derives the name)
     bool    _extraActionAllowed = false;
     Player* _lastArrestTarget   = nullptr;
+    std::uint8_t _seat          = 0;
+
+    // Forced-coup check, at _game.rules().coup_limit coins
+    bool must_coup() const noexcept;
 
-    static constexpr int MANDATORY_COUP_LIMIT = 10;
+    // End of a successful action: consume the bribe bonus or pass the turn
+    void finish_action();
+    // Throwing-API helper: log the failed attempt and throw for `r`
+    void fail(ActionResult r, ActionType type, Player* target = nullptr);
 };
 
 } // namespace coup
\ No newline at end of file
@@ -0,0 +1,50 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GameState.hpp"
+
+namespace coup {
+
+/**
+ * @brief One-line text form of a GameState, for tests, benchmarks and bots.
+ *
+ *     <seats> <turn>[+] <bank> [<window>]
+ *
+ *  - seats:  one entry per seat, joined by '/'. An entry is a two-letter role
+ *            (Go Sp Ba Ge Ju Me), the coins, then the one-turn blocks held
+ *            against that seat, in this order: a = may not arrest,
+ *            s = sanctioned, t = tax blocked, b = bribe blocked; then `>k` if the seat last
+ *            arrested seat k. An all-lowercase role is an eliminated seat.
+ *  - turn:   seat to play; '+' when it still has a bribed extra action.
+ *  - bank:   GameState::bank (a signed count of coins paid in).
+ *  - window: only while a reaction is open: `<Action>@<actor>[><target>]:<seats>`,
+ *            the action (Tax, Bribe or Coup) and the seats still to answer.
+ *
+ * "Baron with 9 coins vs sanctioned Judge, Baron to play" is `Ba9/Ju0s 0 0`;
+ * a coup on a General waiting for its block is `Sp0/Ge5/Ju0 0 0 Coup@0>1:1`.
+ */
+std::string to_position(const GameState& s);
+
+/// Parse the notation above; throws CoupException naming the bad part.
+GameState parse_position(std::string_view text);
+
+/// A named position from a suite file.
+struct NamedPosition {
+    std::string name;
+    GameState   state;
+};
+
+/**
+ * Read a position suite: one `<name> <position>` per line; blank lines and
+ * lines starting with '#' are skipped. Errors carry the line number.
+ */
+std::vector<NamedPosition> read_positions(std::istream& in);
+/// read_positions() on a file; throws CoupException if it cannot be opened.
+std::vector<NamedPosition> load_positions(const std::string& path);
+
+} // namespace coup
@@ -0,0 +1,91 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace coup {
+
+/// splitmix64 finaliser: a bijective 64-bit scramble, the same on every platform.
+constexpr std::uint64_t mix64(std::uint64_t z) noexcept {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/// Stream id of the draws that belong to no seat (dealing, table events).
+inline constexpr std::uint64_t TABLE_STREAM  = 0xFF;
+/// Stream id of a search engine's playouts (it thinks for every seat).
+inline constexpr std::uint64_t SEARCH_STREAM = 0xFE;
+
+/**
+ * Key of the stream for (seed, game, stream). A pure function of its
+ * arguments, so game 812 of a batch gets the same key whichever thread
+ * plays it, and in whatever order. `stream` is a seat (0..5) or TABLE_STREAM.
+ */
+constexpr std::uint64_t stream_key(std::uint64_t seed, std::uint64_t game,
+                                   std::uint64_t stream) noexcept {
+    constexpr std::uint64_t GOLDEN = 0x9E3779B97F4A7C15ull;
+    std::uint64_t k = mix64(seed + GOLDEN);
+    k = mix64(k ^ (game + 1) * GOLDEN);
+    return mix64(k ^ (stream + 1) * 0xD1B54A32D192ED03ull);
+}
+
+/**
+ * xoshiro256**: 32 bytes of state, a few cycles per draw. Meets
+ * UniformRandomBitGenerator, but prefer below() to std distributions when
+ * results must match across standard libraries (their algorithms differ).
+ */
+class Rng {
+public:
+    using result_type = std::uint64_t;
+
+    /// Expand one 64-bit key into the state with splitmix64 (never all zero).
+    explicit constexpr Rng(std::uint64_t key = 0) noexcept {
+        for (std::uint64_t& w : _s) {
+            key += 0x9E3779B97F4A7C15ull;
+            w = mix64(key);
+        }
+    }
+
+    /// The generator for one seat (or TABLE_STREAM) of one game.
+    static constexpr Rng stream(std::uint64_t seed, std::uint64_t game,
+                                std::uint64_t stream) noexcept {
+        return Rng(stream_key(seed, game, stream));
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr result_type operator()() noexcept {
+        const std::uint64_t out = rotl(_s[1] * 5, 7) * 9;
+        const std::uint64_t t   = _s[1] << 17;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+        return out;
+    }
+
+    /// Uniform in [0, n) without modulo bias; n must be positive.
+    constexpr std::uint64_t below(std::uint64_t n) noexcept {
+        const std::uint64_t floor = (0 - n) % n;   // 2^64 mod n: reject [0, floor)
+        for (;;) {
+            const std::uint64_t r = (*this)();
+            if (r >= floor) return r % n;
+        }
+    }
+
+    friend constexpr bool operator==(const Rng&, const Rng&) = default;
+
+private:
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::array<std::uint64_t, 4> _s{};
+};
+
+} // namespace coup
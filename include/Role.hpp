@@ -0,0 +1,45 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace coup {
+
+/**
+ * Compact role identifier, one per role class in include/roles/.
+ */
+enum class RoleId : std::uint8_t {
+    Governor,
+    Spy,
+    Baron,
+    General,
+    Judge,
+    Merchant
+};
+
+inline constexpr std::size_t ROLE_COUNT = 6;
+
+/// Display names, indexed by RoleId.
+inline constexpr std::array<const char*, ROLE_COUNT> ROLE_NAMES = {
+    "Governor", "Spy", "Baron", "General", "Judge", "Merchant"
+};
+
+constexpr const char* role_name(RoleId r) noexcept {
+    return ROLE_NAMES[static_cast<std::size_t>(r)];
+}
+
+/// Inverse of role_name(); false (out untouched) for an unknown name.
+constexpr bool role_from_name(std::string_view name, RoleId& out) noexcept {
+    for (std::size_t i = 0; i < ROLE_COUNT; ++i) {
+        if (name == ROLE_NAMES[i]) {
+            out = static_cast<RoleId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace coup
@@ -0,0 +1,75 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "Role.hpp"
+
+namespace coup {
+
+/**
+ * @brief Every tunable cost and limit of the rules, read by Game, Player and
+ * the role classes at run time.
+ *
+ * A default-constructed RuleSet is the standard game. Balance experiments
+ * change fields here (see RuleSet::set) instead of editing code.
+ */
+struct RuleSet {
+    // Common actions
+    int tax_gain          = 2;    ///< coins from Tax (also what Governor undo takes back)
+    int bribe_cost        = 4;
+    int sanction_cost     = 3;
+    int judge_surcharge   = 1;    ///< extra per side when sanctioning a Judge (paid twice)
+    int coup_cost         = 7;
+    int coup_limit        = 10;   ///< holding this many coins forces a coup
+
+    // Role abilities
+    int governor_tax_gain = 3;
+    int invest_cost       = 3;    ///< Baron
+    int invest_gain       = 6;    ///< Baron
+    int block_coup_cost   = 5;    ///< General
+
+    std::size_t  max_players = 6;     ///< 1..Game::MAX_PLAYERS
+    std::uint8_t roles       = 0x3F;  ///< bit r set = RoleId(r) may be dealt
+
+    constexpr bool has_role(RoleId r) const noexcept {
+        return roles >> static_cast<unsigned>(r) & 1u;
+    }
+
+    /// Coins needed to sanction a target (Judges cost two surcharges).
+    constexpr int sanction_price(bool judge) const noexcept {
+        return sanction_cost + (judge ? 2 * judge_surcharge : 0);
+    }
+
+    /**
+     * Set one field by its name above (e.g. "coup_cost"); false for an
+     * unknown name or a value the field cannot hold (roles above 0xFF,
+     * negative max_players). Used by the sweep driver's command line.
+     */
+    bool set(std::string_view field, int value) noexcept;
+
+    /// nullptr if usable, otherwise what is wrong (negative cost, bad cap, …).
+    [[nodiscard]] const char* invalid() const noexcept;
+
+    friend bool operator==(const RuleSet&, const RuleSet&) = default;
+};
+
+/**
+ * Compile-time rules policy for BasicGameState: the standard game. Every
+ * value is a constant the optimiser folds into the move generator.
+ */
+struct StandardRules {
+    static constexpr RuleSet rules{};
+};
+
+/**
+ * Run-time rules policy for BasicGameState: every use loads from `rules`.
+ * One set per process, shared by all threads; assign it before playing.
+ */
+struct RuntimeRules {
+    static inline RuleSet rules{};
+};
+
+} // namespace coup
@@ -2,11 +2,44 @@
 
 #pragma once
 
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
 namespace coup {
 
+struct RuleSet;
+
+/**
+ * @brief Outcome of a non-throwing action (`Player::try_*`).
+ *
+ * `Ok` means the action was applied; every other value names the rule that
+ * rejected it, in which case the game state is left untouched. Cheap to
+ * return and compare, never allocates.
+ */
+enum class ActionResult : std::uint8_t {
+    Ok,
+    NoPlayers,          ///< game has no active players
+    NotYourTurn,        ///< actor is not the current player
+    MustCoup,           ///< actor holds coup_limit+ coins and must coup
+    InsufficientCoins,  ///< actor (or the payer) cannot afford the cost
+    Sanctioned,         ///< gather/tax blocked by a sanction
+    TaxBlocked,         ///< tax blocked by a Governor
+    BribeBlocked,       ///< bribe blocked by a Judge
+    ArrestBlocked,      ///< arrest blocked by a Spy
+    InvalidTarget,      ///< target is the actor or not in the game
+    SameArrestTarget,   ///< arresting the same player twice in a row
+    TargetHasNoCoins,   ///< arrest target has nothing to steal
+    AlreadyBlocked,     ///< block already applied to this target
+    NothingToUndo,      ///< no matching action in the log
+    NotAvailable        ///< this role cannot perform the action
+};
+
+/// Static, human-readable text for a result code (never allocates).
+const char* describe(ActionResult r) noexcept;
+/// Same text with the numbers of `rules` filled in (the coup limit of MustCoup).
+std::string describe(ActionResult r, const RuleSet& rules);
+
 /**
  * @brief Generic runtime error for illegal game actions.
  *
@@ -18,6 +51,17 @@ class CoupException : public std::logic_error {
 public:
     /// Build a new exception with a short error message.
     explicit CoupException(const std::string &msg);
+
+    /// Build the exception for a rejected `try_*` action.
+    explicit CoupException(ActionResult code);
+    /// Same, worded with the game's rules (see describe()).
+    CoupException(ActionResult code, const RuleSet& rules);
+
+    /// Rule that was broken, `NotAvailable` for free-text exceptions.
+    ActionResult code() const noexcept { return _code; }
+
+private:
+    ActionResult _code = ActionResult::NotAvailable;
 };
 
 /**
@@ -2,11 +2,15 @@
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <vector>
 #include <functional>
 #include <optional>
 
+#include "Random.hpp"
+
 namespace coup { class Game; class Player; }
 
 namespace coup_gui {
@@ -54,6 +58,12 @@ private:
     sf::RenderWindow          _window;
     sf::Font                  _font;
 
+    // Role draws: table stream of (session seed, game number); COUP_SEED
+    // fixes the seed so a session can be replayed
+    std::uint64_t             _seed{0};
+    std::uint64_t             _gameNo{0};
+    coup::Rng                 _rng;
+
     // Menu
     std::vector<Button>       _menuButtons;
     bool                      _showAddDialog{false};
@@ -71,6 +81,11 @@ private:
     std::vector<sf::Text>     _playerCoinTexts;
     std::vector<sf::Text>     _playerRoleTexts;
 
+    // Log window: formatted tail, refreshed only when the game logs something
+    std::deque<std::string>   _logLines;
+    std::uint64_t             _logSeq{0};
+    void syncLog(std::size_t maxLines);
+
     // Popup
     std::optional<std::string> _popupMessage;
     sf::Clock                  _popupClock;
@@ -89,20 +104,12 @@ private:
     sf::Text                   _winnerText;
     std::vector<Button>        _winnerButtons;
 
-   // General’s real-time block-coup prompt
-    coup::Player*      _pendingCoupAttacker = nullptr;
-    coup::Player*      _pendingCoupTarget   = nullptr;
-    bool               _showBlockCoupDialog = false;
-    std::vector<Button> _blockCoupButtons; 
-    
-    void createBlockCoupDialog(coup::Player* general);
-
-    // Judge’s cancel-bribe prompt 
-    coup::Player*      _pendingBribeAttacker  = nullptr;
-    coup::Player*      _pendingBribeTarget    = nullptr;
-    bool               _showBlockBribeDialog  = false;
-    std::vector<Button> _blockBribeButtons;
-    void createBlockBribeDialog(coup::Player* judge);
+    // Reaction prompt for the responder of the game's open window
+    // (Governor undoes a tax, Judge cancels a bribe, General blocks a coup)
+    bool                _showReactionDialog = false;
+    std::vector<Button> _reactionButtons;
+    void createReactionDialog();
+    void answerReaction(bool react);
 };
 
 } // namespace coup_gui
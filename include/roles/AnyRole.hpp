@@ -0,0 +1,27 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <variant>
+
+#include "Role.hpp"
+#include "roles/Governor.hpp"
+#include "roles/Spy.hpp"
+#include "roles/Baron.hpp"
+#include "roles/General.hpp"
+#include "roles/Judge.hpp"
+#include "roles/Merchant.hpp"
+
+namespace coup {
+
+/**
+ * Any one of the six role classes, stored by value. Alternative i is the
+ * class for RoleId(i), so `std::visit` on an AnyRole calls straight into the
+ * (final) role class and the compiler can inline its hooks.
+ */
+using AnyRole = std::variant<Governor, Spy, Baron, General, Judge, Merchant>;
+
+static_assert(std::variant_size_v<AnyRole> == ROLE_COUNT);
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(RoleId::Merchant), AnyRole>,
+                             Merchant>, "AnyRole alternatives must follow RoleId order");
+
+} // namespace coup
@@ -5,12 +5,14 @@
 
 namespace coup {
 
-class Baron : public Player {
+class Baron final : public Player {
 public:
     Baron(Game& game, const std::string& name);
     
-    void invest();                            // spend 3, gain 6
+    void invest();                            // spend 3, gain 6 (RuleSet::invest_*)
+    ActionResult try_invest();                // non-throwing invest()
+    ActionResult can_invest() const noexcept; // Ok if invest() is legal now
     void on_sanction(Player& attacker) override; // compensation +1
 };
 
-} // namespace coup
\ No newline at end of file
+} // namespace coup
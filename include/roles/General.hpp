@@ -6,7 +6,7 @@
 
 namespace coup {
 
-class General : public Player {
+class General final : public Player {
 public:
     /** Construct a General and register it in the game. */
     General(Game& game, const std::string& name);
@@ -19,6 +19,9 @@ public:
      */
     void block_coup(Player& target);
 
+    /** Non-throwing block_coup(): InsufficientCoins / NothingToUndo on failure. */
+    ActionResult try_block_coup(Player& target);
+
     /** Refund 1 coin when this General is arrested. */
     void on_arrest_refund();
 };
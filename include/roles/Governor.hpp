@@ -1,11 +1,10 @@
-
 // Email: realyoavperetz@gmail.com
 #pragma once
 #include "Player.hpp"
 
 namespace coup {
 
-class Governor : public Player {
+class Governor final : public Player {
 public:
     /**
      * Construct a Governor and register it inside the game.
@@ -16,13 +15,16 @@ public:
     /**
      * Collect 3 coins instead of 2.
      */
-    void tax() override;
+    ActionResult try_tax() override;
 
     /**
      * Undo (block) another player's tax action.
-     * @throws CoupException if action_owner did not perform tax recently.
+     * @return NothingToUndo if action_owner did not perform tax recently.
      */
-    void undo(Player& action_owner) override;
+    ActionResult try_undo(Player& action_owner) override;
+
     void block_tax(Player& target);
+    ActionResult try_block_tax(Player& target);
+    ActionResult can_block_tax(const Player& target) const noexcept;
 };
 }
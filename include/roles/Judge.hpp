@@ -5,12 +5,13 @@
 
 namespace coup {
 
-class Judge : public Player {
+class Judge final : public Player {
 public:
     Judge(Game& game, const std::string& name);
     
     void cancel_bribe(Player& target);      // cancel Bribe
-    void on_sanction(Player& attacker) override;   // attacker pays +1
+    ActionResult try_cancel_bribe(Player& target);  // non-throwing cancel_bribe()
+    ActionResult can_cancel_bribe(const Player& target) const noexcept;
 };
 
 } // namespace coup
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 namespace coup {
 
-class Spy : public Player {
+class Spy final : public Player {
 public:
     /** Construct a Spy and register it in the game. */
     Spy(Game& game, const std::string& name);
@@ -20,9 +20,11 @@ public:
 
     /**
      * Prevent target from using arrest on their next turn.
-     * This helper currently marks a flag inside Game (TODO).
+     * Free reaction: costs nothing and does not end the Spy's turn.
      */
     void block_arrest(Player& target);
+    ActionResult try_block_arrest(Player& target);
+    ActionResult can_block_arrest(const Player& target) const noexcept;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "GameState.hpp"
+#include "Move.hpp"
+#include "Random.hpp"
+
+namespace coup_sim {
+
+/**
+ * A cheap move policy on the state engine: `a.pick(s, moves, rng)` returns
+ * one of `moves`, the legal moves of `s` for s.to_move() (never empty; a
+ * reaction window's answers when one is open). Agents are plain types, so
+ * a driver templated on one (playout() below) inlines every decision; use
+ * AnyAgent where the policy is only known at run time.
+ */
+template <class A, class State = coup::GameState>
+concept Agent = requires(A& a, const State& s, const coup::MoveList& moves, coup::Rng& rng) {
+    { a.pick(s, moves, rng) } -> std::same_as<coup::Move>;
+};
+
+// ───────────────── Built-in policies ─────────────────
+
+/// Uniform over the legal moves (the state engine already forces a coup at coup_limit).
+struct UniformAgent {
+    template <class State>
+    coup::Move pick(const State&, const coup::MoveList& moves, coup::Rng& rng) const noexcept {
+        return moves[rng.below(moves.size())];
+    }
+};
+
+/**
+ * Greedy for coins: the move that leaves the mover richest, by its role
+ * (a Governor's tax, a Baron's investment, an arrest that a General takes
+ * back or a Merchant pays to the treasury gains nothing), free moves before
+ * paid ones, the richest target on a tie. Coups (the richest opponent) only
+ * once it holds coup_limit coins, and always blocks a coup on itself.
+ */
+struct IncomeAgent {
+    template <class R>
+    coup::Move pick(const coup::BasicGameState<R>& s, const coup::MoveList& moves,
+                    coup::Rng&) const noexcept {
+        const coup::Move* best = &moves[0];
+        int bestScore = score(s, moves[0]);
+        for (const coup::Move& m : moves) {
+            const int v = score(s, m);
+            if (v > bestScore) { best = &m; bestScore = v; }
+        }
+        return *best;
+    }
+
+private:
+    template <class R>
+    static int score(const coup::BasicGameState<R>& s, const coup::Move& m) noexcept {
+        using coup::ActionType;
+        using coup::RoleId;
+        constexpr int SELF_BLOCK = 1 << 16;   // above any coin score
+        const coup::RuleSet& rs = R::rules;
+        const bool targeted = m.target != coup::NO_SEAT;
+        const RoleId t = targeted ? s.role[m.target] : RoleId::Governor;
+        int gain = 0;
+        switch (m.type) {
+            case ActionType::Gather:    gain = 1; break;
+            case ActionType::Tax:       gain = s.role[m.actor] == RoleId::Governor ? rs.governor_tax_gain
+                                                                                   : rs.tax_gain; break;
+            case ActionType::Invest:    gain = rs.invest_gain - rs.invest_cost; break;
+            case ActionType::Arrest:    gain = t == RoleId::General || t == RoleId::Merchant ? 0 : 1; break;
+            case ActionType::Bribe:     gain = -rs.bribe_cost; break;
+            case ActionType::Sanction:  gain = -rs.sanction_price(t == RoleId::Judge); break;
+            case ActionType::Coup:
+                if (s.coins[m.actor] >= rs.coup_limit) return SELF_BLOCK + s.coins[m.target];
+                gain = -rs.coup_cost;
+                break;
+            case ActionType::BlockCoup:
+                if (m.target == m.actor) return SELF_BLOCK;
+                gain = -rs.block_coup_cost;
+                break;
+            default:                    break;   // free blocks, undos and Pass
+        }
+        return gain * 256 + (targeted ? s.coins[m.target] : 0);
+    }
+};
+
+/**
+ * Coup whenever a coup is legal (the richest opponent), block a coup on
+ * itself, and otherwise play uniformly at random.
+ */
+struct CoupFirstAgent {
+    template <class State>
+    coup::Move pick(const State& s, const coup::MoveList& moves, coup::Rng& rng) const noexcept {
+        const coup::Move* best = nullptr;
+        for (const coup::Move& m : moves) {
+            if (m.type == coup::ActionType::BlockCoup && m.target == m.actor) return m;
+            if (m.type == coup::ActionType::Coup && (!best || s.coins[m.target] > s.coins[best->target])) {
+                best = &m;
+            }
+        }
+        return best ? *best : moves[rng.below(moves.size())];
+    }
+};
+
+static_assert(Agent<UniformAgent> && Agent<IncomeAgent> && Agent<CoupFirstAgent>);
+static_assert(Agent<IncomeAgent, coup::RuntimeGameState>);
+
+// ───────────────── Drivers ─────────────────
+
+/**
+ * Play `s` forward, `agent` choosing for every seat and every reaction,
+ * until the game is over or `cap` moves were played; returns the moves
+ * played. Instantiated per agent type, so the decisions inline.
+ */
+template <class State, Agent<State> A>
+std::size_t playout(State& s, A& agent, coup::Rng& rng, std::size_t cap) {
+    coup::MoveList moves;
+    std::size_t    ply = 0;
+    for (; ply < cap && !s.is_terminal(); ++ply) {
+        s.legal_moves(moves);
+        s.apply(agent.pick(std::as_const(s), moves, rng));
+    }
+    return ply;
+}
+
+/**
+ * Type-erased owner of any Agent on coup::GameState, for a policy chosen
+ * at run time (one virtual call per decision). AnyAgent is itself an
+ * Agent, so every driver above accepts it.
+ */
+class AnyAgent {
+public:
+    template <class A>
+        requires (!std::same_as<std::remove_cvref_t<A>, AnyAgent> && Agent<std::remove_cvref_t<A>>)
+    AnyAgent(A&& agent)   // implicit, like std::function
+        : _self(std::make_unique<Model<std::remove_cvref_t<A>>>(std::forward<A>(agent))) {}
+
+    coup::Move pick(const coup::GameState& s, const coup::MoveList& moves, coup::Rng& rng) {
+        return _self->pick(s, moves, rng);
+    }
+
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual coup::Move pick(const coup::GameState& s, const coup::MoveList& moves,
+                                coup::Rng& rng) = 0;
+    };
+    template <class A>
+    struct Model final : Concept {
+        A agent;
+        explicit Model(A a) : agent(std::move(a)) {}
+        coup::Move pick(const coup::GameState& s, const coup::MoveList& moves,
+                        coup::Rng& rng) override {
+            return agent.pick(s, moves, rng);
+        }
+    };
+
+    std::unique_ptr<Concept> _self;
+};
+
+static_assert(Agent<AnyAgent>);
+
+// ───────────────── Run-time choice ─────────────────
+
+/// The built-in policies, for configs and command lines.
+enum class AgentKind : std::uint8_t { Uniform, Income, CoupFirst };
+
+inline constexpr std::size_t AGENT_COUNT = 3;
+
+/// Command-line names, indexed by AgentKind.
+inline constexpr std::array<const char*, AGENT_COUNT> AGENT_NAMES = {"uniform", "income", "coupfirst"};
+
+/// Inverse of AGENT_NAMES; false (out untouched) for an unknown name.
+constexpr bool agent_from_name(std::string_view name, AgentKind& out) noexcept {
+    for (std::size_t i = 0; i < AGENT_COUNT; ++i) {
+        if (name == AGENT_NAMES[i]) {
+            out = static_cast<AgentKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Call `f` with a value of the built-in agent `kind`: one branch, then
+ * `f` runs instantiated for that agent type (e.g. a whole playout()).
+ */
+template <class F>
+decltype(auto) with_agent(AgentKind kind, F&& f) {
+    switch (kind) {
+        case AgentKind::Income:    return std::forward<F>(f)(IncomeAgent{});
+        case AgentKind::CoupFirst: return std::forward<F>(f)(CoupFirstAgent{});
+        case AgentKind::Uniform:   break;
+    }
+    return std::forward<F>(f)(UniformAgent{});
+}
+
+/// The built-in agent `kind`, type-erased.
+inline AnyAgent make_agent(AgentKind kind) {
+    return with_agent(kind, [](auto agent) { return AnyAgent(agent); });
+}
+
+} // namespace coup_sim
@@ -0,0 +1,265 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Game.hpp"
+#include "Move.hpp"
+#include "Random.hpp"
+#include "sim/Simulator.hpp"
+
+namespace coup_sim {
+
+class Scheduler;
+class Seat;
+
+/// What the engine asks an agent: its own turn, or an answer to game->reaction().
+struct Decision {
+    const coup::Game* game     = nullptr;
+    std::uint8_t      seat     = coup::NO_SEAT;
+    bool              reaction = false;
+    coup::MoveList    moves;            ///< legal answers, never empty; for a reaction {reaction, Pass}
+};
+
+/**
+ * Coroutine type of an agent. An agent is written as one straight loop over
+ * everything its seat is asked, turns and reactions alike:
+ *
+ *     AgentTask my_agent(Seat& seat, ...) {
+ *         while (const Decision* d = co_await seat.next()) {
+ *             seat.play(d->moves[0]);
+ *         }
+ *     }
+ *
+ * next() suspends the agent until the engine needs its seat again and
+ * resumes it with the decision, or with nullptr once the game is over.
+ * Between the two the agent may co_await other work, e.g. hop onto the
+ * Scheduler with `co_await seat.scheduler()->schedule()`; the game waits
+ * without holding a thread. The frame is created suspended and owned by
+ * the Seat it is attached to.
+ */
+class AgentTask {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    AgentTask() = default;
+    explicit AgentTask(handle_type h) noexcept : _h(h) {}
+    AgentTask(AgentTask&& o) noexcept : _h(std::exchange(o._h, {})) {}
+    AgentTask& operator=(AgentTask&& o) noexcept {
+        if (this != &o) {
+            if (_h) _h.destroy();
+            _h = std::exchange(o._h, {});
+        }
+        return *this;
+    }
+    ~AgentTask() { if (_h) _h.destroy(); }
+
+private:
+    friend class Seat;
+    handle_type _h;
+};
+
+/**
+ * One seat of a game driven through coroutines: the channel between the
+ * engine (driver side) and the agent coroutine playing the seat. The driver
+ * resumes the agent with a decision; an agent that answers at once parks in
+ * next() and the driver goes on without suspending, so a decision costs one
+ * resume and the stack never grows with the game. An agent that suspended
+ * elsewhere instead resumes the driver when it reaches next(), on whatever
+ * thread it is running by then.
+ */
+class Seat {
+public:
+    struct Next;
+    struct Answer;
+
+    Seat() = default;
+    Seat(const Seat&)            = delete;
+    Seat& operator=(const Seat&) = delete;
+
+    // Agent side
+    /// Awaitable: the next decision for this seat, nullptr once the game is over.
+    [[nodiscard]] Next next() noexcept;
+    /// Answer the decision next() returned; read when the agent awaits next() again.
+    void play(const coup::Move& m) noexcept { _answer = m; }
+    [[nodiscard]] std::uint8_t index() const noexcept { return _index; }
+    /// Pool running this game, nullptr when the driver has none.
+    [[nodiscard]] Scheduler* scheduler() const noexcept { return _pool; }
+
+    // Driver side
+    /// Place the seat at `index` of the driver's games, run on `pool` (may be null).
+    void place(std::uint8_t index, Scheduler* pool = nullptr) noexcept {
+        _index = index;
+        _pool  = pool;
+    }
+    /// Seat `agent` (created suspended) for a new game; drops the previous one.
+    void attach(AgentTask agent) noexcept;
+    /**
+     * Awaitable for the driver coroutine: hand `d` to the agent and resume
+     * once it answered. Yields the answer, or nullopt if the agent finished
+     * or awaited next() without playing. Rethrows what the agent threw.
+     */
+    [[nodiscard]] Answer decide(const Decision& d) noexcept;
+    /// Tell the agent the game is over (next() yields nullptr) and drop it.
+    void finish() noexcept;
+
+private:
+    friend struct AgentTask::promise_type;
+    /// The agent parked (in next() or at its end): whichever side gets here second goes on.
+    void arrive() noexcept {
+        if (_handoff.exchange(true, std::memory_order_acq_rel) && _engine) {
+            std::exchange(_engine, {}).resume();
+        }
+    }
+
+    AgentTask                 _task;
+    std::coroutine_handle<>   _agent;    ///< where the agent continues, null once it finished
+    std::coroutine_handle<>   _engine;   ///< driver waiting for an answer
+    const Decision*           _decision = nullptr;
+    std::optional<coup::Move> _answer;
+    bool                      _fresh    = false;   ///< _decision not yet seen by the agent
+    std::uint8_t              _index    = coup::NO_SEAT;
+    Scheduler*                _pool     = nullptr;
+    std::atomic<bool>         _handoff{false};
+};
+
+struct AgentTask::promise_type {
+    Seat*              seat = nullptr;
+    std::exception_ptr error;
+
+    struct Final {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(handle_type h) noexcept {
+            Seat& s  = *h.promise().seat;
+            s._agent = {};
+            s.arrive();   // may resume the driver, which may destroy this frame
+        }
+        void await_resume() const noexcept {}
+    };
+
+    AgentTask get_return_object() noexcept { return AgentTask{handle_type::from_promise(*this)}; }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    Final final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+struct Seat::Next {
+    Seat& seat;
+    // a decision the agent has not seen yet (its first) is taken without suspending
+    bool await_ready() const noexcept { return seat._fresh; }
+    void await_suspend(std::coroutine_handle<> agent) noexcept {
+        seat._agent = agent;
+        seat.arrive();
+    }
+    const Decision* await_resume() noexcept {
+        seat._fresh = false;
+        return seat._decision;
+    }
+};
+
+struct Seat::Answer {
+    Seat&           seat;
+    const Decision* d;
+    bool await_ready() const noexcept { return !seat._agent; }
+    bool await_suspend(std::coroutine_handle<> engine) noexcept {
+        seat._decision = d;
+        seat._fresh    = true;
+        seat._answer.reset();
+        seat._engine   = engine;
+        seat._handoff.store(false, std::memory_order_relaxed);
+        seat._agent.resume();
+        // still running: it will resume us from next(); parked: go on now
+        return !seat._handoff.exchange(true, std::memory_order_acq_rel);
+    }
+    std::optional<coup::Move> await_resume() {
+        if (seat._task._h && seat._task._h.promise().error) {
+            std::rethrow_exception(std::exchange(seat._task._h.promise().error, nullptr));
+        }
+        return std::exchange(seat._answer, std::nullopt);
+    }
+};
+
+inline Seat::Next   Seat::next() noexcept                    { return {*this}; }
+inline Seat::Answer Seat::decide(const Decision& d) noexcept { return {*this, &d}; }
+
+/**
+ * Fixed pool of threads resuming coroutine handles from one FIFO queue.
+ * Suspended games cost a frame, not a thread, so a handful of threads can
+ * keep thousands of games in flight.
+ */
+class Scheduler {
+public:
+    /// threads = 0 → hardware_concurrency().
+    explicit Scheduler(std::size_t threads = 0);
+    Scheduler(const Scheduler&)            = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    /// Stops and joins the threads; handles still queued are not resumed.
+    ~Scheduler() = default;
+
+    /// Queue `h` to be resumed on one of the threads.
+    void post(std::coroutine_handle<> h);
+    /// Awaitable: continue the awaiting coroutine on a pool thread.
+    [[nodiscard]] auto schedule() noexcept {
+        struct Hop {
+            Scheduler& pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { pool.post(h); }
+            void await_resume() const noexcept {}
+        };
+        return Hop{*this};
+    }
+    [[nodiscard]] std::size_t threads() const noexcept { return _pool.size(); }
+
+private:
+    void worker(std::stop_token stop);
+
+    std::mutex                          _mutex;
+    std::condition_variable_any         _ready_cv;
+    std::deque<std::coroutine_handle<>> _ready;
+    std::vector<std::jthread>           _pool;   ///< last: joined before the queue goes
+};
+
+/// Makes the agent of one seat of one game (Seat::index() is already set).
+using AgentFactory = std::function<AgentTask(Seat& seat, std::uint64_t game)>;
+
+struct AsyncConfig {
+    SimConfig   sim;             ///< per-game settings, sim.games is the total
+    std::size_t threads = 0;     ///< Scheduler threads, 0 = hardware_concurrency()
+    std::size_t lanes   = 1024;  ///< games in flight at once
+};
+
+/// The random policy of PolicyKind::Random as an agent.
+AgentTask random_agent(Seat& seat, coup::Rng rng);
+/// The greedy policy of PolicyKind::Greedy as an agent.
+AgentTask greedy_agent(Seat& seat);
+
+/**
+ * Self-play with coroutine agents. `lanes` driver coroutines share the
+ * Scheduler's threads; each claims the next game index, deals it exactly as
+ * Simulator::play_game does, asks the seat agents for every turn and
+ * reaction, and moves on to the next index. Per-game results do not depend
+ * on threads or lanes. Rethrows the first exception an agent or game threw.
+ */
+SimStats run_async(const AsyncConfig& cfg, const AgentFactory& make);
+/**
+ * Same with the agents of cfg.sim.policy, each seat drawing from its stream
+ * (sim.seed, game, seat): the totals equal Simulator::run() on cfg.sim.
+ * Throws CoupException for the other policies.
+ */
+SimStats run_async(const AsyncConfig& cfg);
+
+} // namespace coup_sim
@@ -0,0 +1,189 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Action.hpp"
+#include "GameState.hpp"
+#include "Random.hpp"
+#include "Role.hpp"
+#include "Rules.hpp"
+
+namespace coup {
+class Game;
+class Spy;
+}
+
+namespace coup_sim {
+
+// ───────────────── Ranges ─────────────────
+
+/// Coins a seat may hold, both ends included.
+struct CoinRange {
+    std::uint8_t lo = 0;
+    std::uint8_t hi = 0;
+
+    static constexpr CoinRange exact(int c) noexcept {
+        const auto v = clamp(c);
+        return {v, v};
+    }
+    constexpr bool known()            const noexcept { return lo == hi; }
+    constexpr bool contains(int c)    const noexcept { return lo <= c && c <= hi; }
+    constexpr int  width()            const noexcept { return hi - lo + 1; }
+
+    /// Gained `d` coins (paid, for d < 0).
+    constexpr void shift(int d) noexcept {
+        lo = clamp(lo + d);
+        hi = clamp(hi + d);
+    }
+    /// Held at least `c`. A range never empties: a consistent log only narrows it.
+    constexpr void at_least(int c) noexcept {
+        lo = std::max(lo, clamp(c));
+        hi = std::max(hi, lo);
+    }
+    /// Held fewer than `c`.
+    constexpr void below(int c) noexcept {
+        hi = std::min(hi, clamp(c - 1));
+        lo = std::min(lo, hi);
+    }
+    friend bool operator==(const CoinRange&, const CoinRange&) = default;
+
+private:
+    static constexpr std::uint8_t clamp(int c) noexcept {
+        return static_cast<std::uint8_t>(c < 0 ? 0 : c > 255 ? 255 : c);
+    }
+};
+
+/// Per-seat coin ranges, indexed by seat.
+using CoinBounds = std::array<CoinRange, coup::GameState::MAX_SEATS>;
+
+// ───────────────── Log events ─────────────────
+
+/**
+ * What one successful logged action tells about coins. Roles are public, so
+ * this is known exactly: what the actor and the target gained or paid, and
+ * what they must have held for the action to be legal.
+ */
+struct CoinEffect {
+    int  actor_below  = 0;       ///< the actor held fewer coins than this, 0 = no bound
+    int  actor_needs  = 0;       ///< the actor held at least this many
+    int  actor_gain   = 0;
+    int  target_needs = 0;
+    int  target_gain  = 0;
+    bool targeted     = false;   ///< tells nothing once its target is unknown
+
+    /// Apply to the beliefs of the actor and (if known) the target: ranges or distributions.
+    template <class Belief>
+    void apply(Belief& actor, Belief* target) const noexcept {
+        if (actor_below) actor.below(actor_below);
+        if (actor_needs) actor.at_least(actor_needs);
+        actor.shift(actor_gain);
+        if (target) {
+            if (target_needs) target->at_least(target_needs);
+            target->shift(target_gain);
+        }
+    }
+};
+
+/**
+ * The CoinEffect of a successful `type` by a player of role `actor` (whose
+ * target, if any, has role `target`). A Merchant's start-of-turn coin is
+ * logged as its Gather; blocks, cancels and Pass move no coins.
+ */
+CoinEffect coin_effect(coup::ActionType type, coup::RoleId actor, coup::RoleId target,
+                       const coup::RuleSet& rs) noexcept;
+
+// ───────────────── Distributions ─────────────────
+
+/// Coin counts a CoinDist tells apart; the last one stands for itself and more.
+inline constexpr std::size_t BELIEF_COINS = 32;
+
+/**
+ * Probability of each coin count of one seat. Supports the same updates as
+ * CoinRange, so CoinEffect::apply() drives both; an update no count
+ * survives falls back to the nearest count, as CoinRange does.
+ */
+class CoinDist {
+public:
+    /// Certainly 0 coins, as at the start of a game.
+    CoinDist() noexcept { _p[0] = 1.0f; }
+    static CoinDist exact(int c) noexcept;
+    /// Every count of `r` equally likely.
+    static CoinDist uniform(CoinRange r) noexcept;
+
+    float operator[](std::size_t c) const noexcept { return _p[c]; }
+    /// Smallest and largest count with any probability.
+    CoinRange range() const noexcept;
+    double    mean()  const noexcept;
+    /// A count drawn with its probability; one draw from `rng`.
+    int sample(coup::Rng& rng) const noexcept;
+
+    void shift(int d) noexcept;
+    void at_least(int c) noexcept;
+    void below(int c) noexcept;
+
+private:
+    /// Drop every count outside [lo, hi] and renormalise; `fallback` if none is left.
+    void keep(int lo, int hi, int fallback) noexcept;
+
+    std::array<float, BELIEF_COINS> _p{};
+};
+
+/// Per-seat coin distributions, indexed by seat.
+using CoinBeliefs = std::array<CoinDist, coup::GameState::MAX_SEATS>;
+
+// ───────────────── Tracker ─────────────────
+
+/**
+ * Incremental coin beliefs of one player about the others, fed by the
+ * game's display log (Game::log_since): each entry registered since the
+ * last update() costs O(1), so nothing is rescanned between decisions.
+ *
+ * Started at the first entry of a match, every seat is known exactly (all
+ * coin moves are public). Started later, or for a bot that joins a game in
+ * progress, each opponent is uniform over 0..2*coup_limit and the log then
+ * shifts and narrows that as coin_bounds() does for its ranges. Exact
+ * readings (Spy::inspect) collapse a seat until later entries move it.
+ * The observer's own coins are always exact.
+ *
+ * The game must keep logging (Game::set_logging) and outlive the tracker.
+ * A tracker follows one match: update() throws once the game was reset().
+ */
+class CoinTracker {
+public:
+    /**
+     * Beliefs of the player at `observer` of `game`, reading from log entry
+     * `since` (a Game::log_seq() value) on; the default is the match's first.
+     */
+    CoinTracker(const coup::Game& game, std::size_t observer, std::uint64_t since = 0);
+
+    /// Apply the entries logged since the last call; returns how many were read.
+    /// Throws CoupException if the game started a new match since construction.
+    std::size_t update();
+    /// An exact reading of seat `s`; later entries move it as usual.
+    void observe(std::size_t s, int coins) noexcept;
+    /// observe() what `spy` reads of the player at seat `s`.
+    void inspect(const coup::Spy& spy, std::size_t s);
+
+    const CoinDist&    dist(std::size_t s) const noexcept { return _beliefs[s]; }
+    const CoinBeliefs& beliefs()           const noexcept { return _beliefs; }
+    /// Every seat's range(), as coin_bounds() would give it.
+    CoinBounds         bounds()            const noexcept;
+    std::size_t        observer()          const noexcept { return _observer; }
+    /// Log sequence number of the next entry to read.
+    std::uint64_t      seq()               const noexcept { return _seq; }
+
+private:
+    void sync_observer() noexcept;
+
+    const coup::Game* _game;
+    std::size_t       _observer;
+    std::uint32_t     _epoch;   ///< Game::epoch() of the tracked match
+    std::uint64_t     _seq;
+    CoinBeliefs       _beliefs;
+};
+
+} // namespace coup_sim
@@ -0,0 +1,100 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "GameState.hpp"
+#include "Move.hpp"
+#include "Random.hpp"
+#include "Rules.hpp"
+#include "sim/Belief.hpp"
+#include "sim/Mcts.hpp"
+
+namespace coup { class Game; }
+
+namespace coup_sim {
+
+/**
+ * What a seat can know about everyone's coins from the public action log.
+ *
+ * Starts from the oldest of the last `memory` log entries (0 = the whole
+ * log). If that is the first entry of the game every seat starts at 0 coins;
+ * otherwise each seat may hold anything up to twice the coup limit. Every
+ * logged success then moves the range by what it pays or earns (roles are
+ * public), and narrows it by what it proves: a paid action needs its cost,
+ * an arrest needs a coin on the target, and a turn spent on Gather, Tax or
+ * Bribe means the actor was below the coup limit (see coin_effect). The
+ * observer's own seat is always exact. O(entries remembered); CoinTracker
+ * keeps the whole-log answer up to date instead.
+ */
+CoinBounds coin_bounds(const coup::Game& game, std::size_t observer, std::size_t memory = 0);
+
+struct IsmctsConfig {
+    std::size_t   worlds  = 16;    ///< determinizations per move (without a time budget)
+    double        time_ms = 0.0;   ///< wall-clock budget per move, 0 = play exactly `worlds`
+    std::size_t   threads = 1;     ///< searches in parallel, 0 = hardware_concurrency()
+    std::size_t   memory  = 0;     ///< log entries remembered, 0 = the whole log (a CoinTracker)
+    MctsConfig    search;          ///< one world's search; its threads setting is ignored
+    std::uint64_t seed    = 1;
+};
+
+/// What the last IsmctsBot::choose() call did.
+struct IsmctsReport {
+    std::size_t worlds     = 0;    ///< determinizations searched
+    std::size_t iterations = 0;    ///< playouts over all of them
+    double      seconds    = 0.0;  ///< decision latency
+};
+
+/**
+ * Determinized MCTS for hidden coins: the seat to move sees only its own
+ * coins and a CoinBounds for the others.
+ *
+ * Each world fills the hidden counts with a uniform draw from their ranges
+ * and is searched by its own single-threaded MctsBot; worlds are spread over
+ * the threads and the root visit counts summed, and the most visited move
+ * that is legal in the real game is played. Without a time budget the
+ * choice depends only on the seed and the number of worlds, not on the
+ * threads. With one, worlds are searched until it runs out (at least one
+ * each thread), and each world's search stops at the deadline too.
+ */
+class IsmctsBot {
+public:
+    explicit IsmctsBot(const IsmctsConfig& cfg = {});
+
+    /**
+     * Best move for `state.to_move()`, whose own coins in `state` are used
+     * as they are; every other live seat's coins are drawn from `bounds`.
+     * The real coins of those seats only decide which moves are legal.
+     */
+    coup::Move choose(const coup::GameState& state, const CoinBounds& bounds);
+    /// Same with the hidden coins drawn from `beliefs` (e.g. CoinTracker::beliefs()).
+    coup::Move choose(const coup::GameState& state, const CoinBeliefs& beliefs);
+    /// Best move for the seat to move of a live game, bounds read from its log.
+    coup::Move choose(const coup::Game& game);
+
+    /// Restart the random streams, so a game replays identically.
+    void reseed(std::uint64_t seed) noexcept { _cfg.seed = seed; _calls = 0; }
+
+    const IsmctsConfig& config() const noexcept { return _cfg; }
+    const IsmctsReport& last()   const noexcept { return _last; }
+
+private:
+    /// Search with `draw(rng)` making each world.
+    template <class Draw>
+    coup::Move search(const coup::GameState& state, const Draw& draw);
+
+    IsmctsConfig  _cfg;
+    IsmctsReport  _last;
+    std::uint64_t _calls = 0;   ///< mixes the seed so repeated calls differ
+};
+
+/// `state` with every live seat but `observer` holding a uniform draw from `bounds`.
+coup::GameState determinize(const coup::GameState& state, const CoinBounds& bounds,
+                            std::size_t observer, coup::Rng& rng);
+/// `state` with every live seat but `observer` holding a draw from its belief.
+coup::GameState determinize(const coup::GameState& state, const CoinBeliefs& beliefs,
+                            std::size_t observer, coup::Rng& rng);
+
+} // namespace coup_sim
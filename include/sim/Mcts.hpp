@@ -0,0 +1,132 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "GameState.hpp"
+#include "Move.hpp"
+#include "Random.hpp"
+#include "sim/Agent.hpp"
+
+namespace coup { class Game; }
+
+namespace coup_sim {
+
+/**
+ * How MctsBot spreads a search over several threads.
+ *  - Root: every thread grows its own tree, root visit counts are summed.
+ *  - Leaf: one tree, every selected leaf is played out once per thread.
+ */
+enum class Parallelism { Root, Leaf };
+
+struct MctsConfig {
+    std::size_t   iterations  = 2000;   ///< playouts per decision (all threads together)
+    double        time_ms     = 0.0;    ///< wall-clock budget per decision, 0 = none
+    std::size_t   threads     = 1;      ///< search threads, 0 = hardware_concurrency()
+    Parallelism   parallel    = Parallelism::Root;
+    double        exploration = 1.4;    ///< UCT constant
+    std::size_t   max_nodes   = 1 << 16;  ///< node cap per tree, expansion stops there
+    std::size_t   rollout_cap = 200;      ///< playout length before scoring it as a draw
+    AgentKind     rollout     = AgentKind::Uniform;   ///< policy playing the playouts out
+    bool          transpositions = true;  ///< share nodes between identical states
+    std::uint64_t seed        = 1;
+};
+
+/// What the last MctsBot::choose() call did.
+struct MctsReport {
+    std::size_t iterations = 0;   ///< playouts actually run
+    std::size_t nodes      = 0;   ///< tree nodes created (summed over trees)
+    std::size_t tt_hits    = 0;   ///< expansions that reused an existing node
+    double      seconds    = 0.0; ///< decision latency
+};
+
+/**
+ * Monte Carlo Tree Search over coup::GameState (UCT, per-seat rewards so
+ * any number of players works).
+ *
+ * Reactions are ordinary moves of the state model: when a GameState has an
+ * open window the bot answers for the responder (BlockCoup, TaxUndo,
+ * BribeCancel or Pass), and while searching it assumes every seat, including
+ * the opponents' Generals, Governors and Judges, reacts the same way.
+ *
+ * With transpositions on, a tree is a DAG keyed by GameState::hash(), so the
+ * many orders that reach the same coin split share their statistics.
+ */
+class MctsBot {
+public:
+    explicit MctsBot(const MctsConfig& cfg = {});
+
+    /// Best move for `state.to_move()`; `state` must not be terminal.
+    coup::Move choose(const coup::GameState& state);
+    /// Best move for the current player of a live game (seats = Player::seat()).
+    coup::Move choose(const coup::Game& game);
+
+    /// Restart the random streams, so a game replays identically.
+    void reseed(std::uint64_t seed) noexcept { _cfg.seed = seed; _calls = 0; }
+
+    const MctsConfig& config() const noexcept { return _cfg; }
+    const MctsReport& last()   const noexcept { return _last; }
+    /// Root moves of the last choose(), in legal_moves() order, and the visits of each.
+    const coup::MoveList&             last_moves()  const noexcept { return _root; }
+    const std::vector<std::uint32_t>& last_visits() const noexcept { return _visits; }
+
+private:
+    using Rng     = coup::Rng;
+    using Clock   = std::chrono::steady_clock;
+    using Rewards = std::array<float, coup::GameState::MAX_SEATS>;
+
+    struct Edge {
+        coup::Move    move;
+        std::uint32_t child;   ///< node index, NONE until expanded
+    };
+
+    struct Node {
+        coup::GameState state;
+        std::uint32_t   first_edge = 0;
+        std::uint8_t    edges      = 0;
+        std::uint8_t    expanded   = 0;   ///< edges[0, expanded) have a child
+        std::uint32_t   visits     = 0;
+        Rewards         value{};          ///< summed reward per seat
+    };
+
+    /// One search tree; root parallelism owns one per thread.
+    struct Tree {
+        std::vector<Node>                                nodes;
+        std::vector<Edge>                                edges;
+        std::unordered_map<std::uint64_t, std::uint32_t> table;   ///< hash → node
+        std::size_t                                      tt_hits = 0;
+
+        void          reset(const coup::GameState& root, std::size_t reserve);
+        std::uint32_t add(const coup::GameState& s, bool share);
+    };
+
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    /// Walk down from the root and expand one edge; fills `path`, returns the leaf.
+    std::uint32_t select(Tree& t, std::vector<std::uint32_t>& path) const;
+    std::uint32_t best_child(const Tree& t, const Node& n) const;
+    static void   backprop(Tree& t, const std::vector<std::uint32_t>& path,
+                           const Rewards& r, std::uint32_t visits);
+    Rewards       rollout(coup::GameState s, Rng& rng) const;
+    static Rewards score(const coup::GameState& s);
+
+    bool out_of_time() const noexcept;
+
+    std::size_t search_root(Tree& t, Rng& rng, std::size_t budget) const;
+    std::size_t search_leaf(Tree& t, std::uint64_t seed, std::size_t budget,
+                            std::size_t threads) const;
+
+    MctsConfig        _cfg;
+    MctsReport        _last;
+    coup::MoveList             _root;
+    std::vector<std::uint32_t> _visits;
+    std::uint64_t     _calls = 0;   ///< mixes the seed so repeated calls differ
+    Clock::time_point _deadline{};
+};
+
+} // namespace coup_sim
@@ -0,0 +1,65 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GameState.hpp"
+#include "Move.hpp"
+
+namespace coup_sim {
+
+struct PerftResult {
+    /// per_ply[k] = positions exactly k moves below the root (per_ply[0] = 1)
+    std::vector<std::uint64_t> per_ply;
+    /// leaves under each root move, in generation order ("divide")
+    std::vector<std::pair<coup::Move, std::uint64_t>> divide;
+    std::uint64_t nodes   = 0;     ///< sum of per_ply
+    std::size_t   threads = 1;     ///< workers that shared the root moves
+    double        seconds = 0.0;
+
+    std::uint64_t leaves() const noexcept { return per_ply.back(); }
+};
+
+/**
+ * Move-tree count: walks every legal move, reactions included, from `root`
+ * down to `depth` plies with GameState::apply / undo and counts the
+ * positions on each ply. Positions where the game ends early count on
+ * their own ply and have no children. The leaf ply is counted from
+ * legal_moves() alone (bulk counting), as chess perft tools do.
+ *
+ * With threads > 1 (0 = hardware_concurrency()) the root moves are handed
+ * out to a pool one at a time; the counts do not depend on the split.
+ */
+PerftResult perft(const coup::GameState& root, unsigned depth, std::size_t threads = 1);
+
+/// What perft_check() found: nothing, or the first line the engines disagree on.
+struct PerftCheck {
+    std::uint64_t           nodes = 0;   ///< positions compared
+    std::vector<coup::Move> line;        ///< moves from the root to the mismatch
+    std::string             what;        ///< what differed, empty if nothing did
+
+    bool ok() const noexcept { return what.empty(); }
+};
+
+/**
+ * perft() over the real engine: every line of the move tree below `root`,
+ * down to `depth` plies, is replayed through coup::Game::play() (the
+ * Player and role try_* code), and each position is compared with the
+ * GameState one: the legal moves everywhere, and GameState::from(game)
+ * wherever no reaction window is open. A Game cannot undo, so each node
+ * replays its line on a fresh table: keep `depth` shallow.
+ *
+ * The root must be one a Game can seat: any roles, coins, bank, turn and
+ * one-turn blocks, but no open window, extra action or arrest history.
+ * Throws CoupException otherwise.
+ */
+PerftCheck perft_check(const coup::GameState& root, unsigned depth);
+
+/// Print per-ply counts, nodes/sec and, when `divide`, the per-root-move leaves.
+void print_perft(const PerftResult& r, bool divide);
+
+} // namespace coup_sim
@@ -0,0 +1,146 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "Random.hpp"
+#include "Role.hpp"
+#include "sim/Agent.hpp"
+#include "sim/Belief.hpp"
+#include "sim/Ismcts.hpp"
+#include "sim/Mcts.hpp"
+
+namespace coup { class Player; struct Move; }
+
+namespace coup_sim {
+
+// SimStats::per_role is indexed by coup::RoleId
+using coup::ROLE_COUNT;
+using coup::ROLE_NAMES;
+
+/**
+ * How a seat picks its action each turn.
+ *  - Random: uniform over Game::legal_moves(), coup forced at 10+ coins.
+ *  - Greedy: coup as soon as possible, otherwise maximise coin income.
+ *  - Mcts:   every seat (and every reaction) is decided by MctsBot.
+ *  - Agent:  every seat (and every reaction) is decided by the built-in
+ *            agent SimConfig::agent (sim/Agent.hpp) on the state model.
+ *  - Ismcts: like Mcts, but by IsmctsBot: each seat sees only its own coins
+ *            and what the action log tells it about the others'.
+ * Reactions: random responders undo a tax or cancel a bribe 1 time in 4
+ * and block a coup 1 time in 2; greedy ones only block a coup on themselves.
+ */
+enum class PolicyKind { Random, Greedy, Mcts, Agent, Ismcts };
+
+struct SimConfig {
+    std::size_t   games     = 1000;   ///< number of complete games to play
+    std::size_t   players   = 4;      ///< seats per game (2..6)
+    std::uint64_t seed      = 1;      ///< batch seed; see Simulator::play_game
+    PolicyKind    policy    = PolicyKind::Random;
+    std::size_t   max_turns = 1000;   ///< safety cap, game counts as a draw
+    MctsConfig    mcts;               ///< search settings for PolicyKind::Mcts
+    AgentKind     agent     = AgentKind::Uniform;   ///< policy of PolicyKind::Agent
+    IsmctsConfig  ismcts;             ///< search settings for PolicyKind::Ismcts
+    coup::RuleSet rules;              ///< costs and limits (all but Random and Greedy need the standard set)
+};
+
+struct RoleStats {
+    std::uint64_t seats = 0;   ///< how many times the role was dealt
+    std::uint64_t wins  = 0;   ///< how many of those seats won the game
+};
+
+struct SimStats {
+    std::uint64_t games     = 0;   ///< games played
+    std::uint64_t draws     = 0;   ///< games stopped by max_turns
+    std::uint64_t turns     = 0;   ///< completed turns over all games
+    std::uint64_t actions   = 0;   ///< successful actions over all games
+    std::uint64_t illegal   = 0;   ///< rejected action attempts
+    std::uint64_t decisions = 0;   ///< search calls (Mcts and Ismcts policies)
+    double        think     = 0.0; ///< seconds spent inside those calls
+    std::array<RoleStats, ROLE_COUNT> per_role{};
+    double        seconds   = 0.0; ///< wall-clock time of run()
+
+    /// Accumulate another batch of results into this one.
+    void merge(const SimStats& other) noexcept;
+};
+
+/**
+ * Headless self-play driver: deals random roles, plays complete games
+ * through coup::Game and the role classes, and aggregates the results.
+ * No SFML dependency.
+ */
+class Simulator {
+public:
+    explicit Simulator(const SimConfig& cfg);
+
+    /// Play cfg.games games and return the aggregated statistics.
+    SimStats run();
+
+    /**
+     * Play game number `game` of the batch and add its outcome to stats.
+     * Each seat decides with its own stream keyed by (cfg.seed, game, seat)
+     * and the deal uses the table stream, so the result depends on nothing
+     * but those three values: not on the thread, nor on the games before.
+     */
+    void play_game(std::uint64_t game, SimStats& stats);
+
+    /**
+     * Play game number `game` again with the display log on and return it
+     * ("name,Action,Succeeded" lines, as Game::getActionLog()). The game is
+     * the one run() or a Tournament played under the same config.
+     */
+    std::vector<std::string> replay(std::uint64_t game);
+
+private:
+    void play(std::uint64_t game, SimStats& stats, bool log);
+    void take_turn(coup::Game& game, coup::Player& cp, SimStats& stats);
+    void answer_reactions(coup::Game& game, coup::GameState state, const coup::Move& played,
+                          SimStats& stats);
+    coup::Move think(const coup::GameState& state, SimStats& stats);
+    /// SimConfig::agent's pick for state.to_move(), drawing from that seat's `rng`.
+    coup::Move ask_agent(const coup::GameState& state, coup::Rng& rng) const;
+
+    SimConfig  _cfg;
+    MctsBot    _bot;
+    IsmctsBot  _ismcts;
+    coup::Game _game;   ///< reset() per game, so its buffers are reused
+    /// Per-seat coin beliefs of PolicyKind::Ismcts over the whole log, rebuilt per game
+    std::vector<CoinTracker> _beliefs;
+    /// One stream per seat, the table stream last; rekeyed per game
+    std::array<coup::Rng, coup::Game::MAX_PLAYERS + 1> _rng;
+};
+
+/// Build a player of the given role index (a coup::RoleId value).
+std::unique_ptr<coup::Player> make_player(std::size_t role,
+                                          coup::Game& game,
+                                          const std::string& name);
+
+// Policies, shared by Simulator and the coroutine agents (sim/Async.hpp)
+
+/// Random policy: uniform over `moves`, only coups once the mover has coup_limit coins.
+coup::Move random_move(const coup::Game& game, const coup::MoveList& moves, coup::Rng& rng);
+/// Greedy policy: coup the richest opponent, otherwise grow coins fastest.
+coup::Move greedy_move(const coup::Game& game, const coup::MoveList& moves);
+/// Whether a random responder plays `reaction` (see PolicyKind).
+bool random_reacts(const coup::Move& reaction, coup::Rng& rng);
+/// Whether a greedy responder plays `reaction`: only a block of a coup on itself.
+bool greedy_reacts(const coup::Move& reaction) noexcept;
+
+/**
+ * Seat cfg.players game-owned players in a freshly reset() game, roles
+ * drawn uniformly over the enabled ones from `table`, and count the seats.
+ */
+void deal(coup::Game& game, const SimConfig& cfg, coup::Rng& table, SimStats& stats);
+/// Add a finished (or turn-capped) game to stats.
+void tally(const coup::Game& game, std::size_t turns, SimStats& stats);
+
+/// Print a human-readable summary (throughput + win rate per role).
+void print_report(const SimConfig& cfg, const SimStats& stats);
+
+} // namespace coup_sim
@@ -0,0 +1,78 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include "sim/Tournament.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace coup_sim {
+
+/// One point of a sweep: the rules to play and how to print them.
+struct RuleVariant {
+    std::string   label;   ///< e.g. "coup_cost=5 bribe_cost=3", "standard" if unchanged
+    coup::RuleSet rules;
+};
+
+/// One swept RuleSet field and the values it takes.
+struct SweepAxis {
+    std::string      field;
+    std::vector<int> values;
+};
+
+/// Parse "coup_cost=5,7,9"; throws CoupException on a bad spec or unknown field.
+SweepAxis parse_axis(std::string_view spec);
+
+/// RuleSet::set(), throwing CoupException if `field` cannot take `value`.
+void set_rule(coup::RuleSet& rules, const std::string& field, int value);
+
+/**
+ * Cartesian product of `axes` applied on top of `base`, first axis varying
+ * slowest. Throws CoupException if a combination is not a usable RuleSet.
+ */
+std::vector<RuleVariant> make_grid(const coup::RuleSet& base, const std::vector<SweepAxis>& axes);
+
+/// Wilson score interval for `k` successes out of `n` trials.
+struct Interval {
+    double lo = 0.0;
+    double hi = 0.0;
+};
+Interval wilson(std::uint64_t k, std::uint64_t n, double z = 1.96) noexcept;
+
+struct SweepConfig {
+    TournamentConfig         run;        ///< games per variant, players, policy, threads
+    std::vector<RuleVariant> variants;   ///< run.sim.rules is replaced by each in turn
+    double                   z = 1.96;   ///< interval width in standard errors (1.96 = 95 %)
+};
+
+struct SweepResult {
+    RuleVariant variant;
+    SimStats    stats;
+};
+
+/**
+ * Balance sweep over rule variants.
+ *
+ * Variants run one after another, each on a full Tournament thread pool, so
+ * every core works on one variant at a time. Every variant replays the same
+ * random streams (game i deals from Rng::stream(run.sim.seed, i, TABLE_STREAM)
+ * and seat s plays from Rng::stream(run.sim.seed, i, s)), so two variants
+ * differ only by their rules and the comparison between them is paired.
+ */
+class Sweep {
+public:
+    explicit Sweep(const SweepConfig& cfg);
+
+    /// Play every variant; results follow cfg.variants order.
+    std::vector<SweepResult> run();
+
+private:
+    SweepConfig _cfg;
+};
+
+/// Per variant: games, draws, and win rate per role with its interval.
+void print_sweep(const SweepConfig& cfg, const std::vector<SweepResult>& results);
+
+} // namespace coup_sim
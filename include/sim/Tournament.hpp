@@ -0,0 +1,64 @@
+// Email: realyoavperetz@gmail.com
+#pragma once
+
+#include "sim/Simulator.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace coup_sim {
+
+struct TournamentConfig {
+    SimConfig   sim;            ///< per-game settings, sim.games is the total
+    std::size_t threads = 0;    ///< worker count, 0 = hardware_concurrency()
+    std::size_t chunk   = 64;   ///< games a worker claims per pop/steal grain
+};
+
+/**
+ * Multi-threaded self-play scheduler.
+ *
+ * Game indices [0, games) are split into one contiguous range per worker.
+ * A worker pops `chunk` games at a time from the front of its own range;
+ * once it runs dry it steals the back half of the fullest other range, so a
+ * worker stuck on long games never holds up the rest. Every worker owns its
+ * Simulator (and therefore its own coup::Game and players); game i always
+ * draws from the streams keyed by (sim.seed, i, seat), so totals do not
+ * depend on the thread count and Simulator::replay(i) shows any one game.
+ */
+class Tournament {
+public:
+    explicit Tournament(const TournamentConfig& cfg);
+
+    /// Play every game and return the merged statistics.
+    SimStats run();
+
+    /// Number of workers run() will start.
+    std::size_t threads() const noexcept { return _threads; }
+
+private:
+    // A worker's remaining range, packed as (begin << 32) | end so owner pops
+    // and thief splits are single CAS operations.
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bits{0};
+    };
+
+    // Lock-free totals, each worker adds its local SimStats once at exit.
+    struct SharedStats {
+        std::atomic<std::uint64_t> games{0}, draws{0}, turns{0}, actions{0}, illegal{0};
+        std::atomic<std::uint64_t> decisions{0}, think_ns{0};
+        std::array<std::atomic<std::uint64_t>, ROLE_COUNT> seats{}, wins{};
+    };
+
+    void worker(std::size_t id);
+    bool pop(std::size_t id, std::uint64_t& begin, std::uint64_t& end);
+    bool steal(std::size_t id);
+    void publish(const SimStats& local);
+
+    TournamentConfig           _cfg;
+    std::size_t                _threads;
+    std::unique_ptr<Range[]>   _ranges;
+    SharedStats                _shared;
+};
+
+} // namespace coup_sim
@@ -0,0 +1,252 @@
+// Email: realyoavperetz@gmail.com
+// Engine microbenchmarks (no SFML).
+//
+//   ./bench [blocks|rules|agents|search] [-n iterations] [--suite file]
+//
+// blocks: the one-turn block bookkeeping behind next_turn()/is_sanctioned().
+//         "sets" replays the old four unordered_set<Player*> layout, "mask" is
+//         the per-seat packed bitfield Game uses now, and "Game" runs the real
+//         Game::next_turn() path for reference.
+// rules:  random self-play on the state engine (the MCTS rollout workload),
+//         n = games. GameState has the standard rules as compile-time
+//         constants, RuntimeGameState loads the same values from a RuleSet;
+//         both play identical games, only the rule lookups differ.
+// agents: the same workload for each built-in agent (sim/Agent.hpp), n =
+//         games: playout() instantiated for the agent type against the same
+//         agent behind AnyAgent (one virtual call per move).
+// search: MctsBot on every position of a suite file (default
+//         assets/positions.txt), n = playouts per decision (default 2000);
+//         prints the chosen move, the latency and playouts/sec.
+
+#include "Game.hpp"
+#include "GameState.hpp"
+#include "Player.hpp"
+#include "Position.hpp"
+#include "Random.hpp"
+#include "exceptions.hpp"
+#include "roles/Governor.hpp"
+#include "sim/Agent.hpp"
+#include "sim/Mcts.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using coup::Game;
+using coup::Player;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Block bookkeeping as Game stored it before: one hash set per block kind.
+struct SetBlocks {
+    std::unordered_set<const Player*> arrest, sanction, tax, bribe;
+
+    void block_sanction(const Player* p) { sanction.insert(p); }
+    void block_tax(const Player* p)      { tax.insert(p); }
+    bool is_sanctioned(const Player* p)  const { return sanction.count(p) != 0; }
+    bool is_tax_blocked(const Player* p) const { return tax.count(p) != 0; }
+    void next_turn(const Player* p) {
+        arrest.erase(p);
+        tax.erase(p);
+        bribe.erase(p);
+        sanction.erase(p);
+    }
+};
+
+// Same bookkeeping as Game::_blocks: four bits per seat.
+struct MaskBlocks {
+    std::uint32_t bits = 0;
+
+    void block_sanction(const Player* p) { bits |= 2u << (4 * p->seat()); }
+    void block_tax(const Player* p)      { bits |= 4u << (4 * p->seat()); }
+    bool is_sanctioned(const Player* p)  const { return bits >> (4 * p->seat()) & 2u; }
+    bool is_tax_blocked(const Player* p) const { return bits >> (4 * p->seat()) & 4u; }
+    void next_turn(const Player* p)      { bits &= ~(0xFu << (4 * p->seat())); }
+};
+
+// Adapter so the real engine runs the same loop.
+struct GameBlocks {
+    Game& g;
+
+    void block_sanction(Player* p) { g.block_sanction(p); }
+    void block_tax(Player* p)      { g.block_tax(p); }
+    bool is_sanctioned(const Player* p)  const { return g.is_sanctioned(p); }
+    bool is_tax_blocked(const Player* p) const { return g.is_tax_blocked(p); }
+    void next_turn(const Player*)  { g.next_turn(); }
+};
+
+// One "turn": block two opponents, query two players, clear the mover's blocks.
+template <class Blocks>
+double time_blocks(Blocks& b, const std::vector<Player*>& seats, std::size_t iters,
+                   std::size_t& sink) {
+    const std::size_t n = seats.size();
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < iters; ++i) {
+        Player* me = seats[i % n];
+        b.block_sanction(seats[(i + 1) % n]);
+        b.block_tax(seats[(i + 2) % n]);
+        sink += b.is_sanctioned(seats[(i + 3) % n]);
+        sink += b.is_tax_blocked(me);
+        b.next_turn(me);
+    }
+    auto t1 = Clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+}
+
+void bench_blocks(std::size_t iters) {
+    Game game;
+    std::vector<std::unique_ptr<Player>> owned;
+    std::vector<Player*> seats;
+    for (int i = 0; i < 6; ++i) {
+        owned.push_back(std::make_unique<coup::Governor>(game, "P" + std::to_string(i)));
+        seats.push_back(owned.back().get());
+    }
+
+    std::size_t sink = 0;
+    SetBlocks  sets;
+    MaskBlocks mask;
+    GameBlocks real{game};
+    const double tSets = time_blocks(sets, seats, iters, sink);
+    const double tMask = time_blocks(mask, seats, iters, sink);
+    const double tGame = time_blocks(real, seats, iters, sink);
+
+    std::printf("%-28s %10s\n", "block store (6 seats)", "ns/turn");
+    std::printf("%-28s %10.2f\n", "unordered_set x4 (before)", tSets);
+    std::printf("%-28s %10.2f   %.1fx\n", "packed bitfield (after)", tMask, tSets / tMask);
+    std::printf("%-28s %10.2f\n", "coup::Game next_turn path", tGame);
+    std::printf("(checksum %zu)\n", sink);
+}
+
+// Play `games` random 4-seat games to the end (or 300 plies) on engine S.
+template <class S>
+double time_rollouts(std::size_t games, std::uint64_t& moves, std::uint64_t& sink) {
+    coup::Rng       rng(42);
+    coup::MoveList  ml;
+    auto t0 = Clock::now();
+    for (std::size_t g = 0; g < games; ++g) {
+        S s;
+        for (int i = 0; i < 4; ++i) s.add_seat(static_cast<coup::RoleId>(rng.below(coup::ROLE_COUNT)));
+        for (int ply = 0; ply < 300 && !s.is_terminal(); ++ply) {
+            s.legal_moves(ml);
+            s.apply(ml[rng.below(ml.size())]);
+            ++moves;
+        }
+        sink += s.hash();
+    }
+    auto t1 = Clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+void bench_rules(std::size_t games) {
+    coup::RuntimeRules::rules = coup::RuleSet{};
+    std::uint64_t movesC = 0, movesR = 0, sinkC = 0, sinkR = 0;
+    const double tC = time_rollouts<coup::GameState>(games, movesC, sinkC);
+    const double tR = time_rollouts<coup::RuntimeGameState>(games, movesR, sinkR);
+
+    std::printf("%-28s %12s %10s\n", "rules policy", "games/sec", "ns/move");
+    std::printf("%-28s %12.0f %10.2f\n", "RuntimeRules (RuleSet)", games / tR, 1e9 * tR / movesR);
+    std::printf("%-28s %12.0f %10.2f   %.2fx\n", "StandardRules (constexpr)", games / tC,
+                1e9 * tC / movesC, tR / tC);
+    std::printf("(identical games: %s, checksum %llu)\n",
+                sinkC == sinkR && movesC == movesR ? "yes" : "NO",
+                static_cast<unsigned long long>(sinkC));
+}
+
+// Play `games` 4-seat games to the end (or 300 plies), `agent` moving for every seat.
+template <class A>
+double time_agent(A& agent, std::size_t games, std::uint64_t& moves, std::uint64_t& sink) {
+    coup::Rng rng(42);
+    auto t0 = Clock::now();
+    for (std::size_t g = 0; g < games; ++g) {
+        coup::GameState s;
+        for (int i = 0; i < 4; ++i) s.add_seat(static_cast<coup::RoleId>(rng.below(coup::ROLE_COUNT)));
+        moves += coup_sim::playout(s, agent, rng, 300);
+        sink  += s.hash();
+    }
+    auto t1 = Clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+void bench_agents(std::size_t games) {
+    std::printf("%-12s %12s %14s %10s\n", "agent", "games/sec", "inline ns/mv", "AnyAgent");
+    for (std::size_t k = 0; k < coup_sim::AGENT_COUNT; ++k) {
+        const auto kind = static_cast<coup_sim::AgentKind>(k);
+        std::uint64_t movesI = 0, movesA = 0, sinkI = 0, sinkA = 0;
+        const double tI = coup_sim::with_agent(kind, [&](auto agent) {
+            return time_agent(agent, games, movesI, sinkI);
+        });
+        coup_sim::AnyAgent any = coup_sim::make_agent(kind);
+        const double tA = time_agent(any, games, movesA, sinkA);
+        std::printf("%-12s %12.0f %14.2f %9.2fx%s\n", coup_sim::AGENT_NAMES[k], games / tI,
+                    1e9 * tI / movesI, tA / tI,
+                    sinkI == sinkA && movesI == movesA ? "" : "  (games differ!)");
+    }
+}
+
+void bench_search(const std::string& suite, std::size_t iters) {
+    coup_sim::MctsConfig cfg;
+    cfg.iterations = iters;
+    std::printf("%-22s %-16s %10s %14s\n", "position", "move", "ms", "playouts/sec");
+    for (const coup::NamedPosition& p : coup::load_positions(suite)) {
+        if (p.state.is_terminal()) continue;
+        coup_sim::MctsBot bot(cfg);
+        const coup::Move m = bot.choose(p.state);
+        const coup_sim::MctsReport& r = bot.last();
+        std::string move = std::string(coup::action_name(m.type)) + ' ' + std::to_string(m.actor);
+        if (m.target != coup::NO_SEAT) move += "->" + std::to_string(m.target);
+        std::printf("%-22s %-16s %10.2f %14.0f\n", p.name.c_str(), move.c_str(), 1e3 * r.seconds,
+                    r.iterations / (r.seconds > 0.0 ? r.seconds : 1e-9));
+    }
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [blocks|rules|agents|search] [-n iterations] [--suite file]\n", prog);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string which = "blocks";
+    std::size_t iters = 0;
+    std::string suite = "assets/positions.txt";
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-n") && i + 1 < argc) {
+            iters = std::strtoull(argv[++i], nullptr, 10);
+            if (iters == 0) iters = 1;
+        } else if (!std::strcmp(argv[i], "--suite") && i + 1 < argc) {
+            suite = argv[++i];
+        } else if (argv[i][0] != '-') {
+            which = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        if (which == "blocks") {
+            bench_blocks(iters ? iters : 10'000'000);
+        } else if (which == "rules") {
+            bench_rules(iters ? iters : 10'000'000);
+        } else if (which == "agents") {
+            bench_agents(iters ? iters : 200'000);
+        } else if (which == "search") {
+            bench_search(suite, iters ? iters : 2000);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    } catch (const coup::CoupException& ex) {
+        std::fprintf(stderr, "%s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
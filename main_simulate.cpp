@@ -0,0 +1,111 @@
+// Email: realyoavperetz@gmail.com
+// Headless batch self-play: no SFML, prints throughput and win rate per role.
+//
+//   ./simulate [-n games] [-p players] [-s seed] [-t max_turns] [--policy name]
+//              [--iters N] [--ms budget] [-j search_threads] [--parallel root|leaf]
+//              [--rollout agent] [--worlds W] [--memory M] [--replay game]
+//              [--lanes L [--workers T]]
+//
+// The policy is random, greedy, mcts, ismcts, or a built-in agent: uniform,
+// income or coupfirst (sim/Agent.hpp). --rollout picks the agent of the MCTS
+// playouts. With a search policy the report adds the average decision latency.
+// --policy ismcts searches W worlds of hidden coins per move (or as many as
+// --ms allows), read from the last M log entries (0 = all); there -j spreads
+// the worlds over threads and --iters is each world's search.
+// --lanes runs the random or greedy batch as coroutine agents instead: L games
+// in flight on T threads (0 = all cores), with the same totals.
+// --replay G plays only game G of the batch the other options describe (the
+// same game `./tournament` played with those options) and prints its log.
+
+#include "sim/Async.hpp"
+#include "sim/Simulator.hpp"
+#include "exceptions.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+        "usage: %s [-n games] [-p players] [-s seed] [-t max_turns]\n"
+        "          [--policy random|greedy|mcts|ismcts|uniform|income|coupfirst]\n"
+        "          [--iters N] [--ms budget] [-j search_threads] [--parallel root|leaf]\n"
+        "          [--rollout uniform|income|coupfirst] [--worlds W] [--memory M]\n"
+        "          [--replay game] [--lanes L [--workers T]]\n",
+        prog);
+}
+
+int main(int argc, char** argv) {
+    coup_sim::SimConfig cfg;
+    coup_sim::AsyncConfig async;
+    long long replay = -1;
+    bool has_lanes = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!v) { usage(argv[0]); return 1; }
+        if      (!std::strcmp(a, "-n")) cfg.games     = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-p")) cfg.players   = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-s")) cfg.seed      = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-t")) cfg.max_turns = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-j")) cfg.mcts.threads    = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--iters")) cfg.mcts.iterations = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--ms"))    cfg.mcts.time_ms    = std::strtod(v, nullptr);
+        else if (!std::strcmp(a, "--worlds")) cfg.ismcts.worlds = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--memory")) cfg.ismcts.memory = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--replay")) replay = std::strtoll(v, nullptr, 10);
+        else if (!std::strcmp(a, "--lanes")) {
+            async.lanes = std::strtoull(v, nullptr, 10);
+            has_lanes   = true;
+        }
+        else if (!std::strcmp(a, "--workers")) async.threads = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--policy")) {
+            std::string p = v;
+            if      (p == "random") cfg.policy = coup_sim::PolicyKind::Random;
+            else if (p == "greedy") cfg.policy = coup_sim::PolicyKind::Greedy;
+            else if (p == "mcts")   cfg.policy = coup_sim::PolicyKind::Mcts;
+            else if (p == "ismcts") cfg.policy = coup_sim::PolicyKind::Ismcts;
+            else if (coup_sim::agent_from_name(p, cfg.agent)) cfg.policy = coup_sim::PolicyKind::Agent;
+            else { usage(argv[0]); return 1; }
+        }
+        else if (!std::strcmp(a, "--rollout")) {
+            if (!coup_sim::agent_from_name(v, cfg.mcts.rollout)) { usage(argv[0]); return 1; }
+        }
+        else if (!std::strcmp(a, "--parallel")) {
+            std::string p = v;
+            if      (p == "root") cfg.mcts.parallel = coup_sim::Parallelism::Root;
+            else if (p == "leaf") cfg.mcts.parallel = coup_sim::Parallelism::Leaf;
+            else { usage(argv[0]); return 1; }
+        }
+        else { usage(argv[0]); return 1; }
+        ++i;
+    }
+    // the search flags describe the whole move for ISMCTS, one world for its searches
+    cfg.ismcts.search         = cfg.mcts;
+    cfg.ismcts.search.time_ms = 0.0;
+    cfg.ismcts.threads        = cfg.mcts.threads;
+    cfg.ismcts.time_ms        = cfg.mcts.time_ms;
+
+    try {
+        coup_sim::Simulator sim(cfg);
+        if (replay >= 0) {
+            for (const std::string& line : sim.replay(static_cast<std::uint64_t>(replay))) {
+                std::printf("%s\n", line.c_str());
+            }
+            return 0;
+        }
+        coup_sim::SimStats stats;
+        if (has_lanes) {
+            async.sim = cfg;
+            stats = coup_sim::run_async(async);
+        } else {
+            stats = sim.run();
+        }
+        coup_sim::print_report(cfg, stats);
+    } catch (const coup::CoupException& ex) {
+        std::fprintf(stderr, "%s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Email: realyoavperetz@gmail.com
+// Multi-threaded self-play tournament and thread-scaling benchmark.
+//
+//   ./tournament [-n games] [-p players] [-s seed] [-t max_turns] [-j threads]
+//                [-c chunk] [--policy name] [--iters N] [--rollout agent]
+//                [--worlds W] [--scale]
+//
+// The policy is random, greedy, mcts, ismcts, or a built-in agent: uniform,
+// income or coupfirst (sim/Agent.hpp). --rollout picks the agent of the MCTS
+// playouts; --worlds the determinizations per ISMCTS move (--iters each).
+//
+// --scale reruns the same workload with 1, 2, 4, … up to -j threads and
+// prints games/sec and speed-up against the single-thread run.
+
+#include "sim/Tournament.hpp"
+#include "exceptions.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+        "usage: %s [-n games] [-p players] [-s seed] [-t max_turns] [-j threads]\n"
+        "          [-c chunk] [--policy random|greedy|mcts|ismcts|uniform|income|coupfirst]\n"
+        "          [--iters N] [--rollout uniform|income|coupfirst] [--worlds W] [--scale]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    coup_sim::TournamentConfig cfg;
+    cfg.sim.games = 100000;
+    bool scale = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if (!std::strcmp(a, "--scale")) { scale = true; continue; }
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!v) { usage(argv[0]); return 1; }
+        if      (!std::strcmp(a, "-n")) cfg.sim.games     = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-p")) cfg.sim.players   = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-s")) cfg.sim.seed      = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-t")) cfg.sim.max_turns = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-j")) cfg.threads       = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "-c")) cfg.chunk         = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--iters")) cfg.sim.mcts.iterations = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--worlds")) cfg.sim.ismcts.worlds  = std::strtoull(v, nullptr, 10);
+        else if (!std::strcmp(a, "--policy")) {
+            std::string p = v;
+            if      (p == "random") cfg.sim.policy = coup_sim::PolicyKind::Random;
+            else if (p == "greedy") cfg.sim.policy = coup_sim::PolicyKind::Greedy;
+            else if (p == "mcts")   cfg.sim.policy = coup_sim::PolicyKind::Mcts;
+            else if (p == "ismcts") cfg.sim.policy = coup_sim::PolicyKind::Ismcts;
+            else if (coup_sim::agent_from_name(p, cfg.sim.agent)) cfg.sim.policy = coup_sim::PolicyKind::Agent;
+            else { usage(argv[0]); return 1; }
+        }
+        else if (!std::strcmp(a, "--rollout")) {
+            if (!coup_sim::agent_from_name(v, cfg.sim.mcts.rollout)) { usage(argv[0]); return 1; }
+        }
+        else { usage(argv[0]); return 1; }
+        ++i;
+    }
+    cfg.sim.ismcts.search = cfg.sim.mcts;   // one world's search
+
+    try {
+        if (!scale) {
+            coup_sim::Tournament t(cfg);
+            coup_sim::SimStats stats = t.run();
+            std::printf("threads      : %zu\n", t.threads());
+            coup_sim::print_report(cfg.sim, stats);
+            return 0;
+        }
+
+        std::size_t maxThreads = cfg.threads ? cfg.threads : std::thread::hardware_concurrency();
+        if (maxThreads == 0) maxThreads = 1;
+        std::printf("%8s %12s %12s %9s\n", "threads", "seconds", "games/sec", "speed-up");
+        double base = 0.0;
+        for (std::size_t n = 1; ; n = (n * 2 > maxThreads && n < maxThreads) ? maxThreads : n * 2) {
+            coup_sim::TournamentConfig run = cfg;
+            run.threads = n;
+            coup_sim::SimStats s = coup_sim::Tournament(run).run();
+            double gps = s.games / (s.seconds > 0.0 ? s.seconds : 1e-9);
+            if (n == 1) base = gps;
+            std::printf("%8zu %12.3f %12.0f %8.2fx\n", n, s.seconds, gps, gps / base);
+            if (n >= maxThreads) break;
+        }
+    } catch (const coup::CoupException& ex) {
+        std::fprintf(stderr, "%s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
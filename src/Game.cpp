@@ -3,99 +3,444 @@
 
 #include "Game.hpp"
 #include "Player.hpp"
+#include "roles/Governor.hpp"
+#include "roles/Spy.hpp"
+#include "roles/Baron.hpp"
+#include "roles/Judge.hpp"
 
 #include <algorithm>
-#include <sstream>
 
 namespace coup {
 
+// ───────────────── Rules ─────────────────
+
+Game::Game(const RuleSet& rules) {
+    _players.reserve(MAX_PLAYERS);
+    set_rules(rules);
+}
+
+void Game::set_rules(const RuleSet& rules) {
+    if (const char* why = rules.invalid()) {
+        COUP_THROW(why);
+    }
+    if (alive_count() > rules.max_players) {
+        COUP_THROW("More players seated than the new rules allow");
+    }
+    _rules = rules;
+}
+
 // ───────────────── Player management ─────────────────
 
 void Game::add_player(Player* p) {
     if (p == nullptr) {
         COUP_THROW("Null player pointer");
     }
-    if (_players.size() >= 6) {
-        COUP_THROW("Game already has 6 players");
+    if (alive_count() >= _rules.max_players) {
+        COUP_THROW("Game is full");
     }
-    if (std::find(_players.begin(), _players.end(), p) != _players.end()) {
+    if (!_rules.has_role(p->role_id())) {
+        COUP_THROW("Role is not enabled in these rules");
+    }
+    if (has_player(p)) {
         COUP_THROW("Player already in game");
     }
-    _players.push_back(p);
+    if (_names.size() >= NO_SEAT) {
+        COUP_THROW("Too many players joined this game");
+    }
+    const std::uint8_t seat = free_seat();
+    if (seat == NO_SEAT) {
+        COUP_THROW("Every seat of this match was taken");
+    }
+    p->_seat = seat;
+    clear_blocks(seat);
+    _seat_ids[seat] = static_cast<std::uint8_t>(_names.size());
+    _names.push_back(p->name());
+    if (!_alive) _turn = seat;
+    _seats[seat] = p;
+    _alive |= static_cast<std::uint8_t>(1u << seat);
+    _seat_end = static_cast<std::uint8_t>(seat + 1);
+    _players_dirty = true;
 }
 
-void Game::eliminate(Player* p) {
-    if (!p) return;
-    auto it = std::find(_players.begin(), _players.end(), p);
-    if (it == _players.end()) return;
-
-    std::size_t removed = static_cast<std::size_t>(it - _players.begin());
-    _players.erase(it);
+// next seat never taken this match: an eliminated player keeps its seat (a
+// blocked coup restores it there, and the logs still point at it) until reset()
+std::uint8_t Game::free_seat() const noexcept {
+    return _seat_end < MAX_PLAYERS ? _seat_end : NO_SEAT;
+}
 
-    if (_players.empty()) {
-        _turn_idx = 0;
-        return;
+Player& Game::emplace_player(RoleId role, const std::string& name) {
+    switch (role) {
+        case RoleId::Governor: return emplace_player<Governor>(name);
+        case RoleId::Spy:      return emplace_player<Spy>(name);
+        case RoleId::Baron:    return emplace_player<Baron>(name);
+        case RoleId::General:  return emplace_player<General>(name);
+        case RoleId::Judge:    return emplace_player<Judge>(name);
+        case RoleId::Merchant: return emplace_player<Merchant>(name);
     }
-    if (removed < _turn_idx) {
-        --_turn_idx;
-    }
-    if (_turn_idx >= _players.size()) {
-        _turn_idx %= _players.size();
+    COUP_THROW("Unknown role");
+}
+
+SeatHandle Game::handle(const Player& p) const noexcept {
+    return has_player(&p) ? SeatHandle{p._seat, _epoch} : SeatHandle{NO_SEAT, _epoch};
+}
+
+Player* Game::player(SeatHandle h) const noexcept {
+    if (h.epoch != _epoch || h.seat >= MAX_PLAYERS || !(_alive >> h.seat & 1u)) return nullptr;
+    return _seats[h.seat];
+}
+
+void Game::reset() noexcept {
+    _seats.fill(nullptr);
+    _alive     = 0;
+    _turn      = 0;
+    _prev_turn = 0;
+    _seat_end  = 0;
+    _start_pending = false;
+    _players.clear();
+    _players_dirty = false;
+    for (auto& slot : _owned) slot.reset();
+    _bank       = 0;
+    _turn_count = 0;
+    ++_epoch;
+
+    _log.fill(TurnLog{});
+    for (auto& bySeat : _latest) bySeat.fill(RecordRef{});
+    _coup_on.fill(RecordRef{});
+    _log_base += _entries.size();
+    _entries.clear();
+    _names.clear();
+    _seat_ids.fill(0);
+    _blocks = 0;
+    _reaction = {};
+}
+
+bool Game::has_player(const Player* p) const noexcept {
+    return p && &p->_game == this && p->_seat < MAX_PLAYERS
+        && _seats[p->_seat] == p && (_alive >> p->_seat & 1u);
+}
+
+const std::vector<Player*>& Game::playerObjects() const noexcept {
+    if (_players_dirty) {
+        _players.clear();                  // capacity MAX_PLAYERS: never allocates
+        for (unsigned m = _alive; m; m &= m - 1) {
+            _players.push_back(_seats[std::countr_zero(m)]);
+        }
+        _players_dirty = false;
     }
+    return _players;
+}
+
+void Game::eliminate(Player* p) {
+    if (!has_player(p)) return;
+    const std::uint8_t seat = p->_seat;
+    _alive &= static_cast<std::uint8_t>(~(1u << seat));
+    _players_dirty = true;
+    // the turn of a removed player passes on, as if it had ended
+    if (_alive && seat == _turn) _turn = next_alive(seat);
 }
 
 // ───────────────── Turn API ─────────────────
 
 std::string Game::turn() const {
-    if (_players.empty()) {
+    if (!_alive) {
         COUP_THROW("No active players");
     }
-    return _players[_turn_idx]->name();
+    return _seats[_turn]->name();
 }
 
 std::vector<std::string> Game::players() const {
     std::vector<std::string> names;
-    names.reserve(_players.size());
-    for (const Player* p : _players) {
+    names.reserve(alive_count());
+    for (const Player* p : playerObjects()) {
         names.push_back(p->name());
     }
     return names;
 }
 
 void Game::next_turn() {
-    if (_players.empty()) return;
+    if (!_alive) return;
 
     // remove one‐time blocks on the player who just finished a turn
-    _arrest_blocked.erase(_players[_turn_idx]);
-    _tax_blocked.erase(_players[_turn_idx]);
-    _bribe_blocked.erase(_players[_turn_idx]);
-    _sanction_blocked.erase(_players[_turn_idx]);
+    _seats[_turn]->_extraActionAllowed = false;
+    clear_blocks(_turn);
+    ++_turn_count;
     prune_log();
-    _turn_idx = (_turn_idx + 1) % _players.size();
-    _players[_turn_idx]->start_of_turn();
+    _prev_turn = _turn;
+    _turn      = next_alive(_turn);
+    // passive income waits until the window is answered: a blocked coup may
+    // still hand the turn to the restored seat (GameState moves on only then)
+    _start_pending = true;
+    if (!in_reaction()) start_turn();
+}
+
+void Game::start_turn() {
+    if (!_start_pending || !_alive) return;
+    _start_pending = false;
+    dispatch(*_seats[_turn], [](auto& p) { p.start_of_turn(); });
 }
 
 void Game::validate_turn(const Player* p) const {
-    if (_players.empty()) {
-        COUP_THROW("No players in game");
+    ActionResult r = check_turn(p);
+    if (r != ActionResult::Ok) {
+        throw CoupException{r, _rules};
+    }
+}
+
+ActionResult Game::check_turn(const Player* p) const noexcept {
+    if (!_alive) {
+        return ActionResult::NoPlayers;
+    }
+    // an open window is answered first; nobody else moves meanwhile
+    if (_seats[_turn] != p || in_reaction()) {
+        return ActionResult::NotYourTurn;
+    }
+    return ActionResult::Ok;
+}
+
+// ───────────────── Move generation ─────────────────
+
+namespace {
+
+template <class R, class P>
+auto* role_cast(P& p) {
+    return dynamic_cast<std::conditional_t<std::is_const_v<P>, const R, R>*>(&p);
+}
+
+// Call f with the role class that has extra abilities (Governor&, Spy&,
+// Baron&, Judge&), or with Player& otherwise or if the class does not match
+// the role id.
+template <class P, class F>
+decltype(auto) with_role_class(P& p, F&& f) {
+    switch (p.role_id()) {
+        case RoleId::Governor: if (auto* r = role_cast<Governor>(p)) return f(*r); break;
+        case RoleId::Spy:      if (auto* r = role_cast<Spy>(p))      return f(*r); break;
+        case RoleId::Baron:    if (auto* r = role_cast<Baron>(p))    return f(*r); break;
+        case RoleId::Judge:    if (auto* r = role_cast<Judge>(p))    return f(*r); break;
+        default:               break;
+    }
+    return f(p);
+}
+
+// Every legal move of `cp`; role extras are picked at compile time from R.
+template <class R>
+void collect_moves(const R& cp, std::uint8_t self, const std::array<Player*, Game::MAX_PLAYERS>& seats,
+                   unsigned alive, MoveList& out) {
+    constexpr auto ok = ActionResult::Ok;
+
+    if (cp.can_gather() == ok) out.push_back({ActionType::Gather, self, NO_SEAT});
+    if (cp.can_tax()    == ok) out.push_back({ActionType::Tax,    self, NO_SEAT});
+    if (cp.can_bribe()  == ok) out.push_back({ActionType::Bribe,  self, NO_SEAT});
+    if constexpr (std::is_same_v<R, Baron>) {
+        if (cp.can_invest() == ok) out.push_back({ActionType::Invest, self, NO_SEAT});
+    }
+
+    for (unsigned m = alive & ~(1u << self); m; m &= m - 1) {
+        const auto    ti = static_cast<std::uint8_t>(std::countr_zero(m));
+        const Player& t  = *seats[ti];
+        if (cp.can_arrest(t)   == ok) out.push_back({ActionType::Arrest,   self, ti});
+        if (cp.can_sanction(t) == ok) out.push_back({ActionType::Sanction, self, ti});
+        if (cp.can_coup(t)     == ok) out.push_back({ActionType::Coup,     self, ti});
+        if constexpr (std::is_same_v<R, Governor>) {
+            if (cp.can_block_tax(t)    == ok) out.push_back({ActionType::TaxCancel,   self, ti});
+        }
+        if constexpr (std::is_same_v<R, Judge>) {
+            if (cp.can_cancel_bribe(t) == ok) out.push_back({ActionType::BribeCancel, self, ti});
+        }
+        if constexpr (std::is_same_v<R, Spy>) {
+            if (cp.can_block_arrest(t) == ok) out.push_back({ActionType::ArrestBlock, self, ti});
+        }
+    }
+}
+
+// Execute one move as the concrete role R.
+template <class R>
+ActionResult play_as(R& actor, ActionType type, Player* target) {
+    switch (type) {
+        case ActionType::Gather:   return actor.try_gather();
+        case ActionType::Tax:      return actor.try_tax();
+        case ActionType::Bribe:    return actor.try_bribe();
+        case ActionType::Arrest:   return actor.try_arrest(*target);
+        case ActionType::Sanction: return actor.try_sanction(*target);
+        case ActionType::Coup:     return actor.try_coup(*target);
+        case ActionType::Invest:
+            if constexpr (std::is_same_v<R, Baron>)    return actor.try_invest();
+            break;
+        case ActionType::TaxCancel:
+            if constexpr (std::is_same_v<R, Governor>) return actor.try_block_tax(*target);
+            break;
+        case ActionType::BribeCancel:
+            if constexpr (std::is_same_v<R, Judge>)    return actor.try_cancel_bribe(*target);
+            break;
+        case ActionType::ArrestBlock:
+            if constexpr (std::is_same_v<R, Spy>)      return actor.try_block_arrest(*target);
+            break;
+        case ActionType::BlockCoup:
+        case ActionType::TaxUndo:
+        case ActionType::Pass:
+            break;   // reactions, played through Game::react()
+    }
+    return ActionResult::NotAvailable;
+}
+
+// The reaction that answers a window opened by `type`.
+constexpr ActionType answer_to(ActionType type) noexcept {
+    switch (type) {
+        case ActionType::Tax:   return ActionType::TaxUndo;
+        case ActionType::Bribe: return ActionType::BribeCancel;
+        default:                return ActionType::BlockCoup;
+    }
+}
+
+} // namespace
+
+void Game::legal_moves(MoveList& out) const {
+    out.clear();
+    if (!_alive) return;
+    if (in_reaction()) {
+        reaction_moves(out);               // only the responder moves, as in GameState
+        return;
     }
-    if (_players[_turn_idx] != p) {
-        COUP_THROW("Not this player's turn");
+
+    const Player* cp = _seats[_turn];
+    auto collect = [&](const auto& role) { collect_moves(role, _turn, _seats, _alive, out); };
+    if (const AnyRole* r = owned(cp)) {
+        std::visit(collect, *r);           // in-place player: no casts at all
+    } else {
+        with_role_class(*cp, collect);
+    }
+}
+
+void Game::legal_moves(std::vector<Move>& out) const {
+    MoveList list;
+    legal_moves(list);
+    out.assign(list.begin(), list.end());
+}
+
+ActionResult Game::play(const Move& m) {
+    // answers to the reaction window; a couped General answers from out of play
+    if (m.type == ActionType::Pass || m.type == ActionType::TaxUndo || m.type == ActionType::BlockCoup
+        || (m.type == ActionType::BribeCancel && in_reaction() && m.actor == responder())) {
+        return react(m);
+    }
+
+    auto inPlay = [&](std::uint8_t s) { return s < MAX_PLAYERS && (_alive >> s & 1u); };
+    if (!inPlay(m.actor)) return ActionResult::InvalidTarget;
+    Player* actor  = _seats[m.actor];
+    Player* target = nullptr;
+    if (m.target != NO_SEAT) {
+        if (!inPlay(m.target)) return ActionResult::InvalidTarget;
+        target = _seats[m.target];
+    }
+    const bool needsTarget = m.type == ActionType::Arrest || m.type == ActionType::Sanction
+                          || m.type == ActionType::Coup   || m.type == ActionType::TaxCancel
+                          || m.type == ActionType::BribeCancel || m.type == ActionType::ArrestBlock;
+    if (needsTarget && !target) return ActionResult::InvalidTarget;
+
+    auto run = [&](auto& role) { return play_as(role, m.type, target); };
+    if (AnyRole* r = owned(actor)) return std::visit(run, *r);
+    return with_role_class(*actor, run);
+}
+
+// ───────────────── Reaction window ─────────────────
+
+void Game::open_reaction(const Player* actor, ActionType type, const Player* target) noexcept {
+    RoleId role     = RoleId::Governor;
+    int    minCoins = 0;
+    switch (type) {
+        case ActionType::Tax:   role = RoleId::Governor; break;
+        case ActionType::Bribe: role = RoleId::Judge;    break;
+        case ActionType::Coup:  role = RoleId::General;  minCoins = _rules.block_coup_cost; break;
+        default:                return;
     }
+    // register_action() runs before a coup eliminates, so the target is still counted
+    std::uint8_t who = 0;
+    for (unsigned m = _alive & ~(1u << actor->_seat); m; m &= m - 1) {
+        const auto s = static_cast<std::uint8_t>(std::countr_zero(m));
+        if (_seats[s]->role_id() == role && _seats[s]->coins() >= minCoins) {
+            who |= static_cast<std::uint8_t>(1u << s);
+        }
+    }
+    if (!who) return;
+    const bool onTarget = type == ActionType::Coup && target && &target->_game == this;
+    _reaction = {type, actor->_seat, onTarget ? target->_seat : NO_SEAT, who};
+}
+
+void Game::reaction_moves(MoveList& out) const noexcept {
+    out.clear();
+    if (!in_reaction()) return;
+    const std::uint8_t r  = responder();
+    const std::uint8_t on = _reaction.action == ActionType::Coup ? _reaction.target : _reaction.actor;
+    out.push_back({answer_to(_reaction.action), r, on});
+    out.push_back({ActionType::Pass, r, NO_SEAT});
+}
+
+ActionResult Game::react(const Move& m) {
+    if (!in_reaction()) return ActionResult::NotAvailable;
+    if (m.actor != responder()) return ActionResult::NotYourTurn;
+
+    if (m.type == ActionType::Pass) {
+        _reaction.responders &= static_cast<std::uint8_t>(~(1u << m.actor));
+        if (!_reaction.responders) {
+            _reaction = {};
+            start_turn();
+        }
+        return ActionResult::Ok;
+    }
+
+    const Reaction w   = _reaction;
+    Player* who    = _seats[m.actor];
+    Player* owner  = _seats[w.actor];
+    Player* target = w.target != NO_SEAT ? _seats[w.target] : nullptr;
+    if (m.type != answer_to(w.action) || m.target != (target ? w.target : w.actor)) {
+        return ActionResult::NotAvailable;
+    }
+
+    switch (w.action) {
+        case ActionType::Tax: {
+            auto undo = [&](auto& role) {
+                if constexpr (std::is_same_v<std::remove_cvref_t<decltype(role)>, Governor>) {
+                    return role.try_undo(*owner);
+                } else {
+                    return ActionResult::NotAvailable;
+                }
+            };
+            AnyRole* r = owned(who);
+            const ActionResult res = r ? std::visit(undo, *r) : with_role_class(*who, undo);
+            if (res != ActionResult::Ok) return res;
+            register_action(who, ActionType::TaxUndo, owner, true);
+            break;
+        }
+        case ActionType::Bribe:
+            // the bribe stays paid; only the extra action is lost
+            owner->_extraActionAllowed = false;
+            register_action(who, ActionType::BribeCancel, owner, true);
+            break;
+        default:
+            // General::try_block_coup, except that the turn stays where the
+            // coup left it: answering is not the General's turn
+            if (who->coins() < _rules.block_coup_cost) return ActionResult::InsufficientCoins;
+            if (!last_coup(target))                   return ActionResult::NothingToUndo;
+            who->_coins -= _rules.block_coup_cost;
+            cancel_coup(target);
+            register_action(who, ActionType::BlockCoup, target, true);
+            break;
+    }
+    start_turn();              // register_action() closed the window
+    return ActionResult::Ok;
 }
 
 std::string Game::winner() const {
-    if (_players.size() != 1) {
+    if (alive_count() != 1) {
         COUP_THROW("Game is still ongoing");
     }
-    return _players.front()->name();
+    return _seats[_turn]->name();
 }
 // ─── Tax-block helpers ─────────────────────────────
 void Game::block_tax(Player* target) {
-        if (target) _tax_blocked.insert(target);
+        set_block(target, BLOCK_TAX);
     }
-    bool Game::is_tax_blocked(Player* p) const noexcept {
-        return _tax_blocked.count(p) != 0;
+    bool Game::is_tax_blocked(const Player* p) const noexcept {
+        return has_block(p, BLOCK_TAX);
     }
 // ───────────────── Action log helpers ─────────────────
 
@@ -112,113 +457,183 @@ static std::string actionTypeToString(ActionType type) {
         case ActionType::Invest:    return "Invest";
         case ActionType::BlockCoup: return "BlockCoup";
         case ActionType::BribeCancel:   return "BlockBribe";
+        case ActionType::ArrestBlock:   return "BlockArrest";
+        case ActionType::TaxUndo:       return "UndoTax";
+        case ActionType::Pass:          return "Pass";
         default:                    return "";
     }
     return "";
 }
 
+std::uint8_t Game::id_of(const Player* p) const noexcept {
+    return (p && &p->_game == this) ? _seat_ids[p->_seat] : NO_SEAT;
+}
+
 void Game::register_action(Player* actor,
                            ActionType type,
                            Player* target,
                            bool success) {
-    // 1. internal record for blocking logic
-    // 1) record for blocking logic
-    _log.push_back({actor, type, target, _turn_idx});
+    // 1) record for blocking logic (failed attempts cannot be undone)
+    if (success && actor && &actor->_game == this) {
+        TurnLog& bucket = _log[_turn_count % LOG_TURNS];
+        if (bucket.turn != _turn_count) bucket = TurnLog{_turn_count};
+        // a full bucket recycles its last slot; resolve() re-checks the record
+        const std::uint8_t slot = bucket.size < LOG_PER_TURN
+                                      ? bucket.size++
+                                      : static_cast<std::uint8_t>(LOG_PER_TURN - 1);
+        bucket.records[slot] = {actor, type, target, _turn_count};
+
+        const RecordRef ref{_turn_count, slot, true};
+        _latest[actor->_seat][static_cast<std::size_t>(type)] = ref;
+        if (type == ActionType::Coup && target && &target->_game == this) {
+            _coup_on[target->_seat] = ref;
+        }
 
-    // 2) formatted string for the log window
-    std::ostringstream out;
-    out << actor->name()           // who acted
-        << "," << actionTypeToString(type);  // what they did
-    if (target) {
-        out << " for " << target->name();     // optional target
+        // only an answer registers while a window is open (turn actions wait
+        // for it), e.g. a direct General::block_coup(): it closes the window
+        _reaction = {};
+        open_reaction(actor, type, target);
+    }
+
+    // 2) compact record for the log window, formatted on demand
+    if (_logging) {
+        _entries.push_back({_turn_count, id_of(actor), id_of(target), type, success});
     }
-    out << "," << (success ? "Succeeded" : "Failed");
-    _actionLogStrings.push_back(out.str());
 }
 
-// new: last_action definition to satisfy Governor/Judge undo
-ActionRecord* Game::last_action(Player* actor, ActionType type) {
-    for (auto it = _log.rbegin(); it != _log.rend(); ++it) {
-        if (it->actor == actor && it->type == type) {
-            return &*it;
-        }
+const std::string& Game::player_name(std::uint8_t id) const {
+    if (id >= _names.size()) {
+        COUP_THROW("Unknown player id");
     }
-    return nullptr;
+    return _names[id];
+}
+
+std::string Game::format(const LogEntry& e) const {
+    std::string out = player_name(e.actor);             // who acted
+    out += ',';
+    out += actionTypeToString(e.type);                  // what they did
+    if (e.target != NO_SEAT) {
+        out += " for ";
+        out += player_name(e.target);                   // optional target
+    }
+    out += e.success ? ",Succeeded" : ",Failed";
+    return out;
+}
+
+std::span<const LogEntry> Game::log_tail(std::size_t n) const noexcept {
+    const std::size_t count = std::min(n, _entries.size());
+    return {_entries.data() + (_entries.size() - count), count};
+}
+
+std::span<const LogEntry> Game::log_since(std::uint64_t seq) const noexcept {
+    const std::uint64_t from = seq > _log_base ? seq - _log_base : 0;
+    if (from >= _entries.size()) return {};
+    return {_entries.data() + from, static_cast<std::size_t>(_entries.size() - from)};
+}
+
+std::vector<std::string> Game::getActionLog() const {
+    std::vector<std::string> lines;
+    lines.reserve(_entries.size());
+    for (const LogEntry& e : _entries) {
+        lines.push_back(format(e));
+    }
+    return lines;
+}
+
+// ───────────────── Blocking window ─────────────────
+
+ActionRecord* Game::resolve(const RecordRef& ref) noexcept {
+    if (!ref.valid) return nullptr;
+    // only actions from the last full round can still be blocked
+    if (_turn_count - ref.turn > alive_count()) return nullptr;
+    TurnLog& bucket = _log[ref.turn % LOG_TURNS];
+    if (bucket.turn != ref.turn || ref.slot >= bucket.size) return nullptr;
+    return &bucket.records[ref.slot];
+}
+
+ActionRecord* Game::last_action(Player* actor, ActionType type) {
+    if (!actor || &actor->_game != this) return nullptr;
+    ActionRecord* rec = resolve(_latest[actor->_seat][static_cast<std::size_t>(type)]);
+    return (rec && rec->actor == actor && rec->type == type) ? rec : nullptr;
 }
 
 void Game::prune_log() {
-    if (_log.empty()) return;
-    _log.erase(
-        std::remove_if(
-            _log.begin(), _log.end(),
-            [&](const ActionRecord& rec) {
-                std::size_t diff =
-                    (_turn_idx >= rec.turn_idx)
-                        ? (_turn_idx - rec.turn_idx)
-                        : (_players.size() + _turn_idx - rec.turn_idx);
-                return diff > _players.size();
-            }
-        ),
-        _log.end()
-    );
+    _log[_turn_count % LOG_TURNS] = TurnLog{_turn_count};
 }
 
-void Game::block_arrest(Player* target) {
-    if (target) {
-        _arrest_blocked.insert(target);
+// ───────────────── Blocks ─────────────────
+
+void Game::set_block(const Player* p, std::uint32_t kind) noexcept {
+    if (p && &p->_game == this) {
+        _blocks |= kind << (4 * p->_seat);
     }
 }
 
-bool Game::is_arrest_blocked(Player* p) const {
-    return _arrest_blocked.count(p) != 0;
+bool Game::has_block(const Player* p, std::uint32_t kind) const noexcept {
+    return p && &p->_game == this && (_blocks >> (4 * p->_seat) & kind) != 0;
+}
+
+void Game::block_arrest(Player* target) {
+    set_block(target, BLOCK_ARREST);
+}
+
+bool Game::is_arrest_blocked(const Player* p) const noexcept {
+    return has_block(p, BLOCK_ARREST);
 }
 
 void Game::block_sanction(Player* target) {
-    if (target) {
-        _sanction_blocked.insert(target);
-    }
+    set_block(target, BLOCK_SANCTION);
 }
 
-bool Game::is_sanctioned(Player* p) const {
-    return _sanction_blocked.count(p) != 0;
+bool Game::is_sanctioned(const Player* p) const noexcept {
+    return has_block(p, BLOCK_SANCTION);
 }
 
 
+ActionRecord* Game::last_coup(Player* target) {
+    if (!target || &target->_game != this) return nullptr;
+    ActionRecord* rec = resolve(_coup_on[target->_seat]);
+    return (rec && rec->type == ActionType::Coup && rec->target == target) ? rec : nullptr;
+}
+
 void Game::cancel_coup(Player* target) {
     if (!target) {
         COUP_THROW("Null target for cancel_coup");
     }
 
     // Find most recent coup record for this target
-    ActionRecord* rec = nullptr;
-    for (auto it = _log.rbegin(); it != _log.rend(); ++it) {
-        if (it->type == ActionType::Coup && it->target == target) {
-            rec = &*it;
-            break;
-        }
-    }
+    ActionRecord* rec = last_coup(target);
     if (!rec) {
         COUP_THROW("No coup to cancel for this target");
     }
 
-    // Remove the record
-    auto itDel = std::find_if(
-        _log.begin(), _log.end(),
-        [&](const ActionRecord& r) { return &r == rec; }
-    );
-    if (itDel != _log.end()) {
-        _log.erase(itDel);
+    // Seats are never reused within a match, so this holds for any coup on record
+    const std::uint8_t seat = target->_seat;
+    if (_seats[seat] != target) {
+        COUP_THROW("Seat was given to another player");
     }
 
-    // Restore the player if they were removed
-    if (std::find(_players.begin(), _players.end(), target) == _players.end()) {
-        _players.insert(_players.begin() + _turn_idx, target);
+    // Forget the record: drop both index entries that lead to it
+    const RecordRef ref = _coup_on[target->_seat];
+    _coup_on[target->_seat].valid = false;
+    RecordRef& byActor = _latest[rec->actor->_seat][static_cast<std::size_t>(ActionType::Coup)];
+    if (byActor.turn == ref.turn && byActor.slot == ref.slot) byActor.valid = false;
+
+    // Restore the player in its own seat if they were removed
+    if (!(_alive >> seat & 1u)) {
+        // the restored seat lies between the last mover and the current turn
+        // (or the turn came straight back): it would have moved next
+        auto after = [&](std::uint8_t s) { return (s + MAX_PLAYERS - _prev_turn) % MAX_PLAYERS; };
+        const bool skipped = !_alive || _turn == _prev_turn || after(seat) < after(_turn);
+        _alive |= static_cast<std::uint8_t>(1u << seat);
+        _players_dirty = true;
+        if (skipped) _turn = seat;
     }
     }
     void Game::block_bribe(Player* target) {
-    if (target) _bribe_blocked.insert(target);
+    set_block(target, BLOCK_BRIBE);
     }
-    bool Game::is_bribe_blocked(Player* p) const noexcept {
-    return _bribe_blocked.count(p) != 0;
+    bool Game::is_bribe_blocked(const Player* p) const noexcept {
+    return has_block(p, BLOCK_BRIBE);
     }      
 } // namespace coup
\ No newline at end of file
@@ -0,0 +1,453 @@
+// Email: realyoavperetz@gmail.com
+
+
+#include "GameState.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+
+#include "Random.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace coup {
+
+namespace {
+
+// ───────────────── Zobrist keys ─────────────────
+
+constexpr std::size_t SEATS     = GameState::MAX_SEATS;
+constexpr std::size_t SEAT_KEYS = SEATS + 1;   // a seat value, NO_SEAT last
+constexpr std::size_t COIN_KEYS = 32;          // 31 and up share the last key
+
+// Seat masks with their own table, indexed by the mask itself
+enum MaskKey : std::size_t { ALIVE, ARREST, SANCTION, TAX, BRIBE, RESPONDERS, MASK_KEYS };
+
+struct Zobrist {
+    std::array<std::array<std::uint64_t, ROLE_COUNT>, SEATS> role{};
+    std::array<std::array<std::uint64_t, COIN_KEYS>, SEATS>  coins{};
+    std::array<std::array<std::uint64_t, SEAT_KEYS>, SEATS>  last_arrest{};
+    std::array<std::array<std::uint64_t, 1u << SEATS>, MASK_KEYS> mask{};  ///< XOR of the set bits' keys
+    std::array<std::uint64_t, SEATS + 1>          seats{};
+    std::array<std::uint64_t, SEATS>              turn{};
+    std::array<std::uint64_t, ACTION_TYPE_COUNT>  pending{};
+    std::array<std::uint64_t, SEAT_KEYS>          pending_actor{};
+    std::array<std::uint64_t, SEAT_KEYS>          pending_target{};
+    std::uint64_t                                 extra = 0;
+};
+
+// Fixed keys, the same in every build. Index 0 of each table (and NO_SEAT,
+// and Pass) is the default value and keeps key 0, so BasicGameState{} has key 0.
+constexpr Zobrist make_zobrist() {
+    Zobrist z;
+    std::uint64_t n = 0;
+    auto next = [&n] { return mix64(++n * 0x9E3779B97F4A7C15ull); };
+    for (std::size_t s = 0; s < SEATS; ++s) {
+        for (std::size_t v = 1; v < ROLE_COUNT; ++v) z.role[s][v]        = next();
+        for (std::size_t v = 1; v < COIN_KEYS; ++v)  z.coins[s][v]       = next();
+        for (std::size_t v = 0; v < SEATS; ++v)      z.last_arrest[s][v] = next();
+    }
+    for (auto& table : z.mask) {
+        std::array<std::uint64_t, SEATS> bit{};
+        for (auto& b : bit) b = next();
+        for (std::size_t m = 1; m < table.size(); ++m) {
+            for (std::size_t s = 0; s < SEATS; ++s) {
+                if (m >> s & 1u) table[m] ^= bit[s];
+            }
+        }
+    }
+    for (std::size_t v = 1; v < z.seats.size(); ++v) z.seats[v] = next();
+    for (std::size_t v = 1; v < SEATS; ++v)          z.turn[v]  = next();
+    for (std::size_t v = 0; v < ACTION_TYPE_COUNT; ++v) {
+        if (v != static_cast<std::size_t>(ActionType::Pass)) z.pending[v] = next();
+    }
+    for (std::size_t v = 0; v < SEATS; ++v) {
+        z.pending_actor[v]  = next();
+        z.pending_target[v] = next();
+    }
+    z.extra = next();
+    return z;
+}
+
+constexpr Zobrist Z = make_zobrist();
+
+constexpr std::size_t seat_key(std::uint8_t s) noexcept { return s < SEATS ? s : SEATS; }
+constexpr std::size_t coin_key(std::uint8_t c) noexcept { return c < COIN_KEYS ? c : COIN_KEYS - 1; }
+// the bank is not bounded, so it is mixed rather than looked up
+constexpr std::uint64_t bank_key(std::int16_t b) noexcept {
+    return b ? mix64(0xB0A4Bull << 20 ^ static_cast<std::uint16_t>(b)) : 0;
+}
+
+} // namespace
+
+// ───────────────── Construction ─────────────────
+
+template <class R>
+void BasicGameState<R>::add_seat(RoleId r, int c) noexcept {
+    if (seats >= R::rules.max_players) return;
+    role[seats]  = r;
+    coins[seats] = static_cast<std::uint8_t>(std::clamp(c, 0, 255));
+    alive       |= bit(seats);
+    ++seats;
+    rehash();   // construction only, not worth doing by parts
+}
+
+template <class R>
+BasicGameState<R> BasicGameState<R>::from(const Game& game) {
+    BasicGameState s;
+    for (std::size_t i = 0; i < game.seat_count(); ++i) {
+        const Player* p = game.at_seat(i);
+        s.add_seat(p ? p->role_id() : RoleId::Governor, p ? p->coins() : 0);
+        const Player* t = p ? p->last_arrest_target() : nullptr;
+        if (t && game.at_seat(t->seat()) == t) s.last_arrest[i] = t->seat();
+    }
+    s.alive = game.alive_mask();
+    for (const Player* p : game.playerObjects()) {
+        const std::size_t i = p->seat();
+        if (game.is_arrest_blocked(p)) s.arrest_blocked |= bit(i);
+        if (game.is_sanctioned(p))     s.sanctioned     |= bit(i);
+        if (game.is_tax_blocked(p))    s.tax_blocked    |= bit(i);
+        if (game.is_bribe_blocked(p))  s.bribe_blocked  |= bit(i);
+        if (p == game.current_player()) {
+            s.turn         = static_cast<std::uint8_t>(i);
+            s.extra_action = p->has_extra_action() ? 1 : 0;
+        }
+    }
+    s.bank = static_cast<std::int16_t>(game.bank());
+    s.rehash();
+    return s;
+}
+
+// ───────────────── Queries ─────────────────
+
+template <class R>
+int BasicGameState<R>::alive_count() const noexcept {
+    return std::popcount(alive);
+}
+
+template <class R>
+std::uint8_t BasicGameState<R>::to_move() const noexcept {
+    return responders ? static_cast<std::uint8_t>(std::countr_zero(responders)) : turn;
+}
+
+template <class R>
+std::uint8_t BasicGameState<R>::winner() const noexcept {
+    return alive_count() == 1 ? static_cast<std::uint8_t>(std::countr_zero(alive)) : NO_SEAT;
+}
+
+template <class R>
+std::uint64_t BasicGameState<R>::zobrist() const noexcept {
+    std::uint64_t k = Z.seats[seats] ^ Z.turn[turn] ^ (extra_action ? Z.extra : 0) ^ bank_key(bank);
+    for (std::size_t s = 0; s < MAX_SEATS; ++s) {
+        k ^= Z.role[s][static_cast<std::size_t>(role[s])];
+        k ^= Z.coins[s][coin_key(coins[s])];
+        k ^= Z.last_arrest[s][seat_key(last_arrest[s])];
+    }
+    k ^= Z.mask[ALIVE][alive] ^ Z.mask[ARREST][arrest_blocked] ^ Z.mask[SANCTION][sanctioned]
+       ^ Z.mask[TAX][tax_blocked] ^ Z.mask[BRIBE][bribe_blocked] ^ Z.mask[RESPONDERS][responders];
+    k ^= Z.pending[static_cast<std::size_t>(pending)];
+    k ^= Z.pending_actor[seat_key(pending_actor)] ^ Z.pending_target[seat_key(pending_target)];
+    return k;
+}
+
+// ───────────────── Move generation ─────────────────
+
+template <class R>
+void BasicGameState<R>::legal_moves(MoveList& out) const noexcept {
+    out.clear();
+    if (is_terminal()) return;
+
+    if (responders) {
+        const auto r = to_move();
+        switch (pending) {
+            case ActionType::Tax:   out.push_back({ActionType::TaxUndo,     r, pending_actor});  break;
+            case ActionType::Bribe: out.push_back({ActionType::BribeCancel, r, pending_actor});  break;
+            case ActionType::Coup:  out.push_back({ActionType::BlockCoup,   r, pending_target}); break;
+            default: break;
+        }
+        out.push_back({ActionType::Pass, r, NO_SEAT});
+        return;
+    }
+
+    constexpr const RuleSet& rs = R::rules;
+    const std::uint8_t a  = turn;
+    const std::uint8_t ab = bit(a);
+    const int          c  = coins[a];
+    const RoleId       ra = role[a];
+    const bool       must = must_coup(a);
+
+    if (!must && !(sanctioned & ab))                       out.push_back({ActionType::Gather, a, NO_SEAT});
+    if (!must && !(tax_blocked & ab) && !(sanctioned & ab)) out.push_back({ActionType::Tax,    a, NO_SEAT});
+    if (!must && !(bribe_blocked & ab) && c >= rs.bribe_cost) out.push_back({ActionType::Bribe,  a, NO_SEAT});
+    if (has_role(RoleId::Baron) && ra == RoleId::Baron && c >= rs.invest_cost)
+        out.push_back({ActionType::Invest, a, NO_SEAT});
+
+    for (std::uint8_t t = 0; t < seats; ++t) {
+        if (t == a || !is_alive(t)) continue;
+        const std::uint8_t tb = bit(t);
+        if (!(arrest_blocked & ab) && last_arrest[a] != t && coins[t] > 0)
+            out.push_back({ActionType::Arrest, a, t});
+        if (c >= rs.sanction_price(has_role(RoleId::Judge) && role[t] == RoleId::Judge))
+            out.push_back({ActionType::Sanction, a, t});
+        if (c >= rs.coup_cost)
+            out.push_back({ActionType::Coup, a, t});
+        if (has_role(RoleId::Governor) && ra == RoleId::Governor && !(tax_blocked & tb))
+            out.push_back({ActionType::TaxCancel, a, t});
+        if (has_role(RoleId::Judge) && ra == RoleId::Judge && !(bribe_blocked & tb))
+            out.push_back({ActionType::BribeCancel, a, t});
+        if (has_role(RoleId::Spy) && ra == RoleId::Spy && !(arrest_blocked & tb))
+            out.push_back({ActionType::ArrestBlock, a, t});
+    }
+
+    if (out.empty()) {
+        out.push_back({ActionType::Pass, a, NO_SEAT});   // forfeit the turn
+    }
+}
+
+// ───────────────── Apply / undo ─────────────────
+
+template <class R>
+void BasicGameState<R>::gain(std::size_t s, int n) noexcept {
+    const std::uint8_t old = coins[s];
+    coins[s] = static_cast<std::uint8_t>(std::clamp(old + n, 0, 255));
+    key ^= Z.coins[s][coin_key(old)] ^ Z.coins[s][coin_key(coins[s])];
+}
+
+template <class R>
+void BasicGameState<R>::add_bank(int n) noexcept {
+    key ^= bank_key(bank);
+    bank = static_cast<std::int16_t>(bank + n);
+    key ^= bank_key(bank);
+}
+
+template <class R>
+void BasicGameState<R>::flip(std::uint8_t& mask, std::uint8_t bits, std::size_t which) noexcept {
+    mask ^= bits;
+    key  ^= Z.mask[which][bits];
+}
+
+template <class R>
+void BasicGameState<R>::set_extra(std::uint8_t on) noexcept {
+    if (on != extra_action) key ^= Z.extra;
+    extra_action = on;
+}
+
+template <class R>
+void BasicGameState<R>::set_turn(std::uint8_t s) noexcept {
+    key ^= Z.turn[turn] ^ Z.turn[s];
+    turn = s;
+}
+
+template <class R>
+void BasicGameState<R>::set_last_arrest(std::size_t s, std::uint8_t target) noexcept {
+    key ^= Z.last_arrest[s][seat_key(last_arrest[s])] ^ Z.last_arrest[s][seat_key(target)];
+    last_arrest[s] = target;
+}
+
+template <class R>
+void BasicGameState<R>::open_window(ActionType type, std::uint8_t actor, std::uint8_t target,
+                            std::uint8_t who) noexcept {
+    key ^= Z.pending[static_cast<std::size_t>(pending)] ^ Z.pending[static_cast<std::size_t>(type)];
+    key ^= Z.pending_actor[seat_key(pending_actor)]   ^ Z.pending_actor[seat_key(actor)];
+    key ^= Z.pending_target[seat_key(pending_target)] ^ Z.pending_target[seat_key(target)];
+    pending        = type;
+    pending_actor  = actor;
+    pending_target = target;
+    flip(responders, responders ^ who, RESPONDERS);
+}
+
+template <class R>
+void BasicGameState<R>::finish_action() noexcept {
+    if (extra_action) {
+        set_extra(0);
+    } else {
+        next_turn();
+    }
+}
+
+template <class R>
+void BasicGameState<R>::next_turn() noexcept {
+    // remove one-time blocks on the seat that just finished its turn
+    const std::uint8_t mine = bit(turn);
+    flip(arrest_blocked, arrest_blocked & mine, ARREST);
+    flip(sanctioned,     sanctioned     & mine, SANCTION);
+    flip(tax_blocked,    tax_blocked    & mine, TAX);
+    flip(bribe_blocked,  bribe_blocked  & mine, BRIBE);
+    set_extra(0);
+    if (!alive) return;
+
+    // next set bit after `turn`, wrapping around
+    const unsigned rot = (static_cast<unsigned>(alive) | (static_cast<unsigned>(alive) << seats))
+                         >> (turn + 1);
+    set_turn(static_cast<std::uint8_t>((turn + 1 + std::countr_zero(rot)) % seats));
+
+    if (has_role(RoleId::Merchant) && role[turn] == RoleId::Merchant && coins[turn] >= 3) {
+        gain(turn, 1);
+    }
+}
+
+template <class R>
+void BasicGameState<R>::resolve(bool blocked, std::uint8_t by) noexcept {
+    const ActionType   type   = pending;
+    const std::uint8_t actor  = pending_actor;
+    const std::uint8_t target = pending_target;
+    open_window(ActionType::Pass, NO_SEAT, NO_SEAT, 0);
+
+    switch (type) {
+        case ActionType::Tax:
+            if (blocked) {
+                const int refund = std::min<int>(R::rules.tax_gain, coins[actor]);
+                gain(actor, -refund);
+                add_bank(refund);
+            }
+            finish_action();
+            break;
+        case ActionType::Bribe:
+            // the bribe stays paid either way; the turn goes on
+            if (blocked) set_extra(0);
+            break;
+        case ActionType::Coup:
+            if (blocked) {
+                gain(by, -R::rules.block_coup_cost);
+            } else {
+                const std::uint8_t gone = bit(target);
+                flip(alive,          alive          & gone, ALIVE);
+                flip(arrest_blocked, arrest_blocked & gone, ARREST);
+                flip(sanctioned,     sanctioned     & gone, SANCTION);
+                flip(tax_blocked,    tax_blocked    & gone, TAX);
+                flip(bribe_blocked,  bribe_blocked  & gone, BRIBE);
+            }
+            finish_action();
+            break;
+        default:
+            break;
+    }
+}
+
+template <class R>
+typename BasicGameState<R>::Undo BasicGameState<R>::apply(const Move& m) noexcept {
+    constexpr const RuleSet& rs = R::rules;
+    Undo u{*this};
+    const std::uint8_t a = m.actor;
+    const std::uint8_t t = m.target;
+
+    if (responders) {
+        if (m.type == ActionType::Pass) {
+            flip(responders, responders & bit(a), RESPONDERS);
+            if (!responders) resolve(false, NO_SEAT);
+        } else {
+            resolve(true, a);
+        }
+        assert(key == zobrist());
+        return u;
+    }
+
+    auto others = [&](RoleId r, int minCoins) {
+        std::uint8_t mask = 0;
+        if (!has_role(r)) return mask;      // folds away for a constexpr policy
+        for (std::uint8_t s = 0; s < seats; ++s) {
+            if (s != a && is_alive(s) && role[s] == r && coins[s] >= minCoins) mask |= bit(s);
+        }
+        return mask;
+    };
+
+    switch (m.type) {
+        case ActionType::Gather:
+            gain(a, 1);
+            finish_action();
+            break;
+
+        case ActionType::Tax:
+            if (has_role(RoleId::Governor) && role[a] == RoleId::Governor) {
+                gain(a, rs.governor_tax_gain);
+                add_bank(-rs.governor_tax_gain);
+            } else {
+                gain(a, rs.tax_gain);
+            }
+            open_window(ActionType::Tax, a, NO_SEAT, others(RoleId::Governor, 0));
+            if (!responders) resolve(false, NO_SEAT);
+            break;
+
+        case ActionType::Bribe:
+            gain(a, -rs.bribe_cost);
+            add_bank(rs.bribe_cost);
+            set_extra(1);
+            open_window(ActionType::Bribe, a, NO_SEAT, others(RoleId::Judge, 0));
+            if (!responders) resolve(false, NO_SEAT);
+            break;
+
+        case ActionType::Arrest:
+            gain(t, -1);
+            gain(a, 1);
+            if (has_role(RoleId::General) && role[t] == RoleId::General) gain(t, 1);
+            if (has_role(RoleId::Merchant) && role[t] == RoleId::Merchant) {
+                // pays up to 2 to the bank instead of losing 1 to the thief
+                gain(a, -1);
+                gain(t, 1);
+                const int pay = std::min<int>(2, coins[t]);
+                gain(t, -pay);
+                add_bank(pay);
+            }
+            set_last_arrest(a, t);
+            finish_action();
+            break;
+
+        case ActionType::Sanction:
+            gain(a, -rs.sanction_cost);
+            if (has_role(RoleId::Judge) && role[t] == RoleId::Judge) {
+                gain(a, -2 * rs.judge_surcharge);
+                add_bank(rs.judge_surcharge);
+            }
+            if (has_role(RoleId::Baron) && role[t] == RoleId::Baron) gain(t, 1);
+            flip(sanctioned, bit(t) & ~sanctioned, SANCTION);
+            finish_action();
+            break;
+
+        case ActionType::Coup:
+            gain(a, -rs.coup_cost);
+            open_window(ActionType::Coup, a, t, others(RoleId::General, rs.block_coup_cost));
+            if (!responders) resolve(false, NO_SEAT);
+            break;
+
+        case ActionType::Invest:
+            gain(a, rs.invest_gain - rs.invest_cost);
+            finish_action();
+            break;
+
+        case ActionType::TaxCancel:
+            flip(tax_blocked, bit(t) & ~tax_blocked, TAX);
+            finish_action();
+            break;
+
+        case ActionType::BribeCancel:
+            flip(bribe_blocked, bit(t) & ~bribe_blocked, BRIBE);
+            finish_action();
+            break;
+
+        case ActionType::ArrestBlock:
+            flip(arrest_blocked, bit(t) & ~arrest_blocked, ARREST);
+            break;
+
+        case ActionType::Pass:
+            next_turn();   // nothing legal: forfeit
+            break;
+
+        case ActionType::BlockCoup:
+        case ActionType::TaxUndo:
+            break;         // reactions only
+    }
+    assert(key == zobrist());   // the incremental updates missed nothing
+    return u;
+}
+
+template <class R>
+void BasicGameState<R>::undo(const Move&, const Undo& u) noexcept {
+    *this = u.saved;
+    assert(key == zobrist());
+}
+
+template struct BasicGameState<StandardRules>;
+template struct BasicGameState<RuntimeRules>;
+
+} // namespace coup
@@ -23,144 +23,62 @@ void Player::gain(int amount) noexcept {
 }
 
 // Constructor: register player with game
-Player::Player(Game& game, const std::string& name)
-    : _name(name), _game(game) {
+Player::Player(Game& game, const std::string& name, RoleId role)
+    : _name(name), _game(game), _role(role) {
     game.add_player(this);
 }
 
-// ───────── default actions ─────────
+void Player::change_role(const std::string& newRole) {
+    if (!role_from_name(newRole, _role)) {
+        COUP_THROW("Unknown role: " + newRole);
+    }
+}
+
+// ───────── throwing API (thin wrappers over try_*) ─────────
+
+void Player::fail(ActionResult r, ActionType type, Player* target) {
+    _game.register_action(this, type, target, false);
+    throw CoupException{r, _game.rules()};
+}
 
 void Player::gather() {
-    try {
-        _game.validate_turn(this);
-        if (_coins >= MANDATORY_COUP_LIMIT) {
-            COUP_THROW("Must coup when holding 10 or more coins");
-        }
-        if (_game.is_sanctioned(this)) {
-            COUP_THROW("Gather action is blocked by sanction");
-        }
-        gain(1);
-        _game.register_action(this, ActionType::Gather, nullptr, true);
-        if (_extraActionAllowed) {
-            _extraActionAllowed = false;
-        } else {
-            _game.next_turn();
-        }
-    } catch (const CoupException&) {
-        _game.register_action(this, ActionType::Gather, nullptr, false);
-        throw;
-    }
+    ActionResult r = try_gather();
+    if (r != ActionResult::Ok) fail(r, ActionType::Gather);
 }
 
 void Player::tax() {
-    try {
-        _game.validate_turn(this);
-        if (_coins >= MANDATORY_COUP_LIMIT) {
-            COUP_THROW("Must coup when holding 10 or more coins");
-        }
-        if (_game.is_tax_blocked(this)) {
-            COUP_THROW("Tax action is blocked by Governor");
-        }
-        if (_game.is_sanctioned(this)) {
-            
-            COUP_THROW("Tax action is blocked by sanction");
-        }
-        gain(2);
-        _game.register_action(this, ActionType::Tax, nullptr, true);
-        if (_extraActionAllowed) {
-            _extraActionAllowed = false;
-        } else {
-            _game.next_turn();
-        }
-    } catch (const CoupException&) {
-        _game.register_action(this, ActionType::Tax, nullptr, false);
-        throw;
-    }
+    ActionResult r = try_tax();
+    if (r != ActionResult::Ok) fail(r, ActionType::Tax);
 }
 
 void Player::bribe() {
-    try {
-        _game.validate_turn(this);
-        if (_coins >= MANDATORY_COUP_LIMIT) {
-            COUP_THROW("Must coup when holding 10 or more coins");
-        }
-        if (_game.is_bribe_blocked(this)) {
-            COUP_THROW("Can't bribe – you are blocked");
-        }
-        spend(4);
-        _game.bank() += 4;
-        _extraActionAllowed = true;
-        _game.register_action(this, ActionType::Bribe, nullptr, true);
-        // stay on the same turn (extra‐action)
-    } catch (const CoupException&) {
-        _game.register_action(this, ActionType::Bribe, nullptr, false);
-        throw;
-    }
+    ActionResult r = try_bribe();
+    if (r != ActionResult::Ok) fail(r, ActionType::Bribe);
 }
 
 void Player::arrest(Player& target) {
-    try {
-        _game.validate_turn(this);
-        // no mandatory-coup here
-        if (&target == this) {
-            COUP_THROW("Cannot arrest self");
-        }
-        if (_game.is_arrest_blocked(this)) {
-            COUP_THROW("Arrest action is blocked for this turn");
-        }
-        if (_lastArrestTarget == &target) {
-            COUP_THROW("Cannot arrest same target twice in a row");
-        }
-        if (target.coins() <= 0) {
-            COUP_THROW("Target has no coins to steal");
-        }
-        _game.register_action(this, ActionType::Arrest, &target, true);
-        target.spend(1);
-        gain(1);
-        if(target.role()== "General") {target.gain(1);}
-        target.on_arrested(*this);
-        _lastArrestTarget = &target;
-        if (_extraActionAllowed) {
-            _extraActionAllowed = false;
-        } else {
-            _game.next_turn();
-        }
-    } catch (const CoupException&) {
-        _game.register_action(this, ActionType::Arrest, &target, false);
-        throw;
-    }
+    ActionResult r = try_arrest(target);
+    if (r != ActionResult::Ok) fail(r, ActionType::Arrest, &target);
 }
 
 void Player::sanction(Player& target) {
-    try {
-        _game.validate_turn(this);
-        // no mandatory-coup here
-        // cost 3
-        spend(3);
-        // extra 1 if target is Judge
-        if (target.role() == "Judge") {
-            spend(1);
-        }
-        target.on_sanction(*this);
-        _game.register_action(this, ActionType::Sanction, &target, true);
-        _game.block_sanction(&target);
-        if (_extraActionAllowed) {
-            _extraActionAllowed = false;
-        } else {
-            _game.next_turn();
-        }
-    } catch (const CoupException&) {
-        _game.register_action(this, ActionType::Sanction, &target, false);
-        throw;
-    }
+    ActionResult r = try_sanction(target);
+    if (r != ActionResult::Ok) fail(r, ActionType::Sanction, &target);
 }
 
 void Player::coup(Player& target) {
-    _game.validate_turn(this);
-    // coup cost is 7, no mandatory-coup check here (this *is* the coup)
-    spend(7);
-    _game.register_action(this, ActionType::Coup, &target, true);
-    _game.eliminate(&target);
+    ActionResult r = try_coup(target);
+    if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+}
+
+void Player::undo(Player& action_owner) {
+    ActionResult r = try_undo(action_owner);
+    if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+}
+
+// ───────── default actions ─────────
+
+void Player::finish_action() {
     if (_extraActionAllowed) {
         _extraActionAllowed = false;
     } else {
@@ -168,8 +86,133 @@ void Player::coup(Player& target) {
     }
 }
 
-void Player::undo(Player&) {
-    COUP_THROW("This role cannot undo actions");
+// ───────── rule checks ─────────
+
+bool Player::must_coup() const noexcept {
+    return _coins >= _game.rules().coup_limit;
+}
+
+ActionResult Player::can_gather() const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    if (must_coup())                    return ActionResult::MustCoup;
+    if (_game.is_sanctioned(this))      return ActionResult::Sanctioned;
+    return ActionResult::Ok;
+}
+
+ActionResult Player::can_tax() const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    if (must_coup())                    return ActionResult::MustCoup;
+    if (_game.is_tax_blocked(this))     return ActionResult::TaxBlocked;
+    if (_game.is_sanctioned(this))      return ActionResult::Sanctioned;
+    return ActionResult::Ok;
+}
+
+ActionResult Player::can_bribe() const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    if (must_coup())                     return ActionResult::MustCoup;
+    if (_game.is_bribe_blocked(this))    return ActionResult::BribeBlocked;
+    if (_coins < _game.rules().bribe_cost) return ActionResult::InsufficientCoins;
+    return ActionResult::Ok;
+}
+
+ActionResult Player::can_arrest(const Player& target) const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    // no mandatory-coup here
+    if (&target == this || !_game.has_player(&target)) return ActionResult::InvalidTarget;
+    if (_game.is_arrest_blocked(this))  return ActionResult::ArrestBlocked;
+    if (_lastArrestTarget == &target)   return ActionResult::SameArrestTarget;
+    if (target.coins() <= 0)            return ActionResult::TargetHasNoCoins;
+    return ActionResult::Ok;
+}
+
+ActionResult Player::can_sanction(const Player& target) const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    // no mandatory-coup here
+    if (&target == this || !_game.has_player(&target)) return ActionResult::InvalidTarget;
+    // priced by role id, as try_sanction() charges it
+    const int cost = _game.rules().sanction_price(target.role_id() == RoleId::Judge);
+    if (_coins < cost)                  return ActionResult::InsufficientCoins;
+    return ActionResult::Ok;
+}
+
+ActionResult Player::can_coup(const Player& target) const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    // no mandatory-coup check here (this *is* the coup)
+    if (&target == this || !_game.has_player(&target)) return ActionResult::InvalidTarget;
+    if (_coins < _game.rules().coup_cost) return ActionResult::InsufficientCoins;
+    return ActionResult::Ok;
+}
+
+// ───────── default actions ─────────
+
+ActionResult Player::try_gather() {
+    if (ActionResult r = can_gather(); r != ActionResult::Ok) return r;
+
+    gain(1);
+    _game.register_action(this, ActionType::Gather, nullptr, true);
+    finish_action();
+    return ActionResult::Ok;
+}
+
+ActionResult Player::try_tax() {
+    if (ActionResult r = can_tax(); r != ActionResult::Ok) return r;
+
+    gain(_game.rules().tax_gain);
+    _game.register_action(this, ActionType::Tax, nullptr, true);
+    finish_action();
+    return ActionResult::Ok;
+}
+
+ActionResult Player::try_bribe() {
+    if (ActionResult r = can_bribe(); r != ActionResult::Ok) return r;
+
+    _coins -= _game.rules().bribe_cost;
+    _game.bank() += _game.rules().bribe_cost;
+    _extraActionAllowed = true;
+    _game.register_action(this, ActionType::Bribe, nullptr, true);
+    // stay on the same turn (extra‐action)
+    return ActionResult::Ok;
+}
+
+ActionResult Player::try_arrest(Player& target) {
+    if (ActionResult r = can_arrest(target); r != ActionResult::Ok) return r;
+
+    _game.register_action(this, ActionType::Arrest, &target, true);
+    target.spend(1);
+    gain(1);
+    if (target.role_id() == RoleId::General) {target.gain(1);}
+    _game.dispatch(target, [&](auto& t) { t.on_arrested(*this); });
+    _lastArrestTarget = &target;
+    finish_action();
+    return ActionResult::Ok;
+}
+
+ActionResult Player::try_sanction(Player& target) {
+    if (ActionResult r = can_sanction(target); r != ActionResult::Ok) return r;
+
+    // a Judge costs two surcharges, one of them paid to the bank
+    const bool judge = target.role_id() == RoleId::Judge;
+    _coins -= _game.rules().sanction_price(judge);
+    if (judge) _game.bank() += _game.rules().judge_surcharge;
+    _game.dispatch(target, [&](auto& t) { t.on_sanction(*this); });
+    _game.register_action(this, ActionType::Sanction, &target, true);
+    _game.block_sanction(&target);
+    finish_action();
+    return ActionResult::Ok;
+}
+
+ActionResult Player::try_coup(Player& target) {
+    if (ActionResult r = can_coup(target); r != ActionResult::Ok) return r;
+
+    _coins -= _game.rules().coup_cost;
+    _game.register_action(this, ActionType::Coup, &target, true);
+    _game.eliminate(&target);
+    finish_action();
+    return ActionResult::Ok;
+}
+
+ActionResult Player::try_undo(Player&) {
+    return ActionResult::NotAvailable;
 }
 
-} // namespace coup
\ No newline at end of file
+} // namespace coup
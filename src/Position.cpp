@@ -0,0 +1,202 @@
+// Email: realyoavperetz@gmail.com
+#include "Position.hpp"
+#include "exceptions.hpp"
+
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <istream>
+
+namespace coup {
+
+namespace {
+
+constexpr std::array<const char*, ROLE_COUNT> ROLE_CODES = {"Go", "Sp", "Ba", "Ge", "Ju", "Me"};
+constexpr std::array<char, 4> BLOCK_FLAGS = {'a', 's', 't', 'b'};
+
+constexpr char lower(char c) noexcept { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; }
+
+// Block masks in BLOCK_FLAGS order
+std::array<std::uint8_t*, 4> block_masks(GameState& s) noexcept {
+    return {&s.arrest_blocked, &s.sanctioned, &s.tax_blocked, &s.bribe_blocked};
+}
+
+void append_int(std::string& out, int v) {
+    char buf[8];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof buf, v);
+    out.append(buf, end);
+}
+
+// Cursor over the text; every read either succeeds or throws
+struct Reader {
+    std::string_view text;
+    std::size_t      at = 0;
+
+    [[noreturn]] void fail(const char* what) const {
+        COUP_THROW("Bad position (" + std::string(what) + " at column " + std::to_string(at + 1) +
+                   "): " + std::string(text));
+    }
+    bool done() const noexcept { return at == text.size(); }
+    char peek() const noexcept { return done() ? '\0' : text[at]; }
+    bool eat(char c) noexcept {
+        if (peek() != c) return false;
+        ++at;
+        return true;
+    }
+    void expect(char c, const char* what) { if (!eat(c)) fail(what); }
+
+    int number(int lo, int hi, const char* what) {
+        int v = 0;
+        const char* first = text.data() + at;
+        auto [end, ec] = std::from_chars(first, text.data() + text.size(), v);
+        if (ec != std::errc{} || v < lo || v > hi) fail(what);
+        at += static_cast<std::size_t>(end - first);
+        return v;
+    }
+    std::uint8_t seat(std::size_t seats, const char* what) {
+        const char c = peek();
+        if (c < '0' || c >= static_cast<char>('0' + seats)) fail(what);
+        ++at;
+        return static_cast<std::uint8_t>(c - '0');
+    }
+};
+
+} // namespace
+
+// ───────────────── Serializer ─────────────────
+
+std::string to_position(const GameState& s) {
+    std::string out;
+    out.reserve(64);
+    const std::array<std::uint8_t, 4> blocks = {s.arrest_blocked, s.sanctioned,
+                                                s.tax_blocked, s.bribe_blocked};
+    for (std::size_t i = 0; i < s.seats; ++i) {
+        if (i) out += '/';
+        const char* code = ROLE_CODES[static_cast<std::size_t>(s.role[i])];
+        out += s.is_alive(i) ? code[0] : lower(code[0]);
+        out += code[1];
+        append_int(out, s.coins[i]);
+        for (std::size_t f = 0; f < BLOCK_FLAGS.size(); ++f) {
+            if (blocks[f] >> i & 1u) out += BLOCK_FLAGS[f];
+        }
+        if (s.last_arrest[i] != NO_SEAT) {
+            out += '>';
+            out += static_cast<char>('0' + s.last_arrest[i]);
+        }
+    }
+    out += ' ';
+    out += static_cast<char>('0' + s.turn);
+    if (s.extra_action) out += '+';
+    out += ' ';
+    append_int(out, s.bank);
+    if (s.in_reaction()) {
+        out += ' ';
+        out += action_name(s.pending);
+        out += '@';
+        out += static_cast<char>('0' + s.pending_actor);
+        if (s.pending_target != NO_SEAT) {
+            out += '>';
+            out += static_cast<char>('0' + s.pending_target);
+        }
+        out += ':';
+        for (std::size_t i = 0; i < s.seats; ++i) {
+            if (s.responders >> i & 1u) out += static_cast<char>('0' + i);
+        }
+    }
+    return out;
+}
+
+// ───────────────── Parser ─────────────────
+
+GameState parse_position(std::string_view text) {
+    GameState s;
+    Reader    r{text};
+    const auto masks = block_masks(s);
+
+    // seats
+    do {
+        if (s.seats == GameState::MAX_SEATS) r.fail("more than 6 seats");
+        const std::size_t i = s.seats++;
+        if (r.at + 2 > text.size()) r.fail("role");
+        const char c0 = text[r.at], c1 = text[r.at + 1];
+        std::size_t role = 0;
+        while (role < ROLE_COUNT &&
+               !(lower(ROLE_CODES[role][0]) == lower(c0) && ROLE_CODES[role][1] == c1)) {
+            ++role;
+        }
+        if (role == ROLE_COUNT) r.fail("role");
+        r.at += 2;
+        s.role[i]  = static_cast<RoleId>(role);
+        if (c0 != lower(c0)) s.alive |= static_cast<std::uint8_t>(1u << i);
+        s.coins[i] = static_cast<std::uint8_t>(r.number(0, 255, "coins"));
+        for (std::size_t f = 0; f < BLOCK_FLAGS.size(); ++f) {
+            if (r.eat(BLOCK_FLAGS[f])) *masks[f] |= static_cast<std::uint8_t>(1u << i);
+        }
+        if (r.eat('>')) s.last_arrest[i] = r.seat(GameState::MAX_SEATS, "arrest target");
+    } while (r.eat('/'));
+    for (std::size_t i = 0; i < s.seats; ++i) {
+        if (s.last_arrest[i] != NO_SEAT && (s.last_arrest[i] >= s.seats || s.last_arrest[i] == i)) {
+            COUP_THROW("Bad position (arrest target of seat " + std::to_string(i) + "): " + std::string(text));
+        }
+    }
+
+    // turn, bank
+    r.expect(' ', "missing turn");
+    s.turn = r.seat(s.seats, "turn");
+    if (!s.is_alive(s.turn)) r.fail("turn on an eliminated seat");
+    if (r.eat('+')) s.extra_action = 1;
+    r.expect(' ', "missing bank");
+    s.bank = static_cast<std::int16_t>(r.number(-32768, 32767, "bank"));
+
+    // reaction window
+    if (r.eat(' ')) {
+        const std::size_t at = text.find('@', r.at);
+        if (at == std::string_view::npos) r.fail("window");
+        const std::string_view name = text.substr(r.at, at - r.at);
+        if      (name == action_name(ActionType::Tax))   s.pending = ActionType::Tax;
+        else if (name == action_name(ActionType::Bribe)) s.pending = ActionType::Bribe;
+        else if (name == action_name(ActionType::Coup))  s.pending = ActionType::Coup;
+        else r.fail("window action");
+        r.at = at + 1;
+        s.pending_actor = r.seat(s.seats, "window actor");
+        if (r.eat('>')) s.pending_target = r.seat(s.seats, "window target");
+        if ((s.pending == ActionType::Coup) != (s.pending_target != NO_SEAT)) r.fail("window target");
+        r.expect(':', "window responders");
+        while (!r.done()) s.responders |= static_cast<std::uint8_t>(1u << r.seat(s.seats, "responder"));
+        if (!s.responders || (s.responders & ~s.alive)) r.fail("window responders");
+    }
+    if (!r.done()) r.fail("trailing text");
+
+    s.rehash();
+    return s;
+}
+
+// ───────────────── Suites ─────────────────
+
+std::vector<NamedPosition> read_positions(std::istream& in) {
+    std::vector<NamedPosition> out;
+    std::string line;
+    for (std::size_t n = 1; std::getline(in, line); ++n) {
+        const std::size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#') continue;
+        const std::size_t gap  = line.find_first_of(" \t", first);
+        const std::size_t pos  = line.find_first_not_of(" \t\r", gap);
+        const std::size_t last = line.find_last_not_of(" \t\r");
+        if (pos == std::string::npos) COUP_THROW("Line " + std::to_string(n) + ": name without a position");
+        try {
+            out.push_back({line.substr(first, gap - first),
+                           parse_position(std::string_view(line).substr(pos, last + 1 - pos))});
+        } catch (const CoupException& ex) {
+            COUP_THROW("Line " + std::to_string(n) + ": " + ex.what());
+        }
+    }
+    return out;
+}
+
+std::vector<NamedPosition> load_positions(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) COUP_THROW("Cannot open " + path);
+    return read_positions(in);
+}
+
+} // namespace coup
@@ -0,0 +1,61 @@
+// Email: realyoavperetz@gmail.com
+
+
+#include "Rules.hpp"
+#include "Game.hpp"
+
+namespace coup {
+
+namespace {
+
+struct Field {
+    std::string_view name;
+    int RuleSet::*   member;
+};
+
+constexpr Field FIELDS[] = {
+    {"tax_gain",          &RuleSet::tax_gain},
+    {"bribe_cost",        &RuleSet::bribe_cost},
+    {"sanction_cost",     &RuleSet::sanction_cost},
+    {"judge_surcharge",   &RuleSet::judge_surcharge},
+    {"coup_cost",         &RuleSet::coup_cost},
+    {"coup_limit",        &RuleSet::coup_limit},
+    {"governor_tax_gain", &RuleSet::governor_tax_gain},
+    {"invest_cost",       &RuleSet::invest_cost},
+    {"invest_gain",       &RuleSet::invest_gain},
+    {"block_coup_cost",   &RuleSet::block_coup_cost},
+};
+
+} // namespace
+
+bool RuleSet::set(std::string_view field, int value) noexcept {
+    if (field == "roles") {
+        if (value < 0 || value > 0xFF) return false;
+        roles = static_cast<std::uint8_t>(value);
+        return true;
+    }
+    if (field == "max_players") {
+        if (value < 0) return false;
+        max_players = static_cast<std::size_t>(value);
+        return true;
+    }
+    for (const Field& f : FIELDS) {
+        if (f.name == field) {
+            this->*f.member = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* RuleSet::invalid() const noexcept {
+    for (const Field& f : FIELDS) {
+        if (this->*f.member < 0) return "Rule costs and gains must not be negative";
+    }
+    if (coup_limit < 1)      return "coup_limit must be at least 1";
+    if (max_players < 1 || max_players > Game::MAX_PLAYERS) return "max_players must be 1..6";
+    if (roles == 0 || roles >> ROLE_COUNT)                  return "roles must enable 1..6 of the six roles";
+    return nullptr;
+}
+
+} // namespace coup
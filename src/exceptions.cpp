@@ -2,9 +2,44 @@
 
 
 #include "exceptions.hpp"
+#include "Rules.hpp"
 
 namespace coup {
 
 CoupException::CoupException(const std::string &msg) : std::logic_error(msg) {}
 
+CoupException::CoupException(ActionResult code)
+    : std::logic_error(describe(code)), _code(code) {}
+
+CoupException::CoupException(ActionResult code, const RuleSet& rules)
+    : std::logic_error(describe(code, rules)), _code(code) {}
+
+const char* describe(ActionResult r) noexcept {
+    switch (r) {
+        case ActionResult::Ok:                return "Ok";
+        case ActionResult::NoPlayers:         return "No players in game";
+        case ActionResult::NotYourTurn:       return "Not this player's turn";
+        case ActionResult::MustCoup:          return "Must coup when holding the coup limit or more coins";
+        case ActionResult::InsufficientCoins: return "Not enough coins";
+        case ActionResult::Sanctioned:        return "Action is blocked by sanction";
+        case ActionResult::TaxBlocked:        return "Tax action is blocked by Governor";
+        case ActionResult::BribeBlocked:      return "Can't bribe – you are blocked";
+        case ActionResult::ArrestBlocked:     return "Arrest action is blocked for this turn";
+        case ActionResult::InvalidTarget:     return "Invalid target";
+        case ActionResult::SameArrestTarget:  return "Cannot arrest same target twice in a row";
+        case ActionResult::TargetHasNoCoins:  return "Target has no coins to steal";
+        case ActionResult::AlreadyBlocked:    return "Target is already blocked";
+        case ActionResult::NothingToUndo:     return "No action to undo";
+        case ActionResult::NotAvailable:      return "This role cannot perform that action";
+    }
+    return "";
+}
+
+std::string describe(ActionResult r, const RuleSet& rules) {
+    if (r == ActionResult::MustCoup) {
+        return "Must coup when holding " + std::to_string(rules.coup_limit) + " or more coins";
+    }
+    return describe(r);
+}
+
 }
@@ -1,4 +1,5 @@
 // Email: realyoavperetz@gmail.com
+#include <cstdlib>
 #include <iostream>
 #include <random>
 #include <unordered_set>
@@ -53,6 +54,14 @@ GameWindow::GameWindow(Game& game)
     if (!_font.loadFromFile("assets/sansation.ttf"))
         std::cerr << "[WARN] font assets/sansation.ttf not found\n";
 
+    if (const char* env = std::getenv("COUP_SEED")) {
+        _seed = std::strtoull(env, nullptr, 10);
+    } else {
+        _seed = (std::uint64_t{std::random_device{}()} << 32) | std::random_device{}();
+    }
+    _rng = Rng::stream(_seed, _gameNo, TABLE_STREAM);
+    std::cerr << "[INFO] COUP_SEED=" << _seed << '\n';
+
     // --- Menu buttons ---
     float x = PANEL_PAD;
     _menuButtons.push_back(makeButton("Add Player", x, PANEL_PAD/2, [&]() {
@@ -124,8 +133,8 @@ void GameWindow::run() {
             logCreated = true;
         }
 
-        // Check for winner
-        if (!_showWinnerDialog && _game.playerObjects().size() == 1) {
+        // Check for winner (once no General can still block the last coup)
+        if (!_showWinnerDialog && !_showReactionDialog && _game.playerObjects().size() == 1) {
             createWinnerDialog(_game.winner());
         }
 
@@ -148,12 +157,11 @@ void GameWindow::run() {
         // Draw the log window if open
         if (logCreated) {
             logWindow.clear({20,20,20});
-            auto logs = _game.getActionLog();
             float y = 10.f;
             size_t maxLines = (LOG_H - 20) / 20;
-            size_t start = logs.size() > maxLines ? logs.size() - maxLines : 0;
-            for (size_t i = start; i < logs.size(); ++i) {
-                sf::Text entry(logs[i], _font, 14);
+            syncLog(maxLines);
+            for (const std::string& line : _logLines) {
+                sf::Text entry(line, _font, 14);
                 entry.setFillColor(sf::Color::White);
                 entry.setPosition(10.f, y);
                 logWindow.draw(entry);
@@ -191,11 +199,13 @@ void GameWindow::createWinnerDialog(const std::string& winner) {
     float bx = _winnerBg.getPosition().x + 20.f;
     float by = _winnerBg.getPosition().y + 100.f;
     _winnerButtons.push_back(makeButton("Play Again", bx, by, [&]() {
-        // reset game state
-        while (!_game.playerObjects().empty()) {
-            _game.eliminate(_game.playerObjects().front());
-        }
+        // reset game state (frees the players, keeps the buffers)
+        _game.reset();
+        _logLines.clear();
+        _logSeq = _game.log_seq();
+        _rng = Rng::stream(_seed, ++_gameNo, TABLE_STREAM);
         _showWinnerDialog = false;
+        _showReactionDialog = false;
         _state = WindowState::Menu;
     }));
     _winnerButtons.push_back(makeButton("Quit", bx + BUTTON_W + BUTTON_SP, by, [&]() {
@@ -204,7 +214,6 @@ void GameWindow::createWinnerDialog(const std::string& winner) {
 }
 
 void GameWindow::handleMenuEvents() {
-    static std::mt19937 rng(std::random_device{}());
     sf::Event e;
     while (_window.pollEvent(e)) {
         // 1) Window close
@@ -256,25 +265,16 @@ void GameWindow::handleMenuEvents() {
                 }
 
                 // b) pick a random role
-                static const std::vector<std::string> ALL = {
-                    "Governor","Spy","Baron","General","Judge","Merchant"
-                };
-                std::uniform_int_distribution<size_t> dist(0, ALL.size() - 1);
-                const std::string role = ALL[dist(rng)];
+                const RoleId role = static_cast<RoleId>(_rng.below(ROLE_COUNT));
 
-                // c) try to construct the new player (catches >6 players)
+                // c) try to create the new player (catches >6 players);
+                //    the game owns it, so nothing leaks on Play Again
                 try {
-                    if      (role == "Governor") new Governor(_game, _newPlayerName);
-                    else if (role == "Spy")      new Spy(_game, _newPlayerName);
-                    else if (role == "Baron")    new Baron(_game, _newPlayerName);
-                    else if (role == "General")  new General(_game, _newPlayerName);
-                    else if (role == "Judge")    new Judge(_game, _newPlayerName);
-                    else                         new Merchant(_game, _newPlayerName);
-
-                    showPopup("Added " + _newPlayerName + " as " + role);
+                    _game.emplace_player(role, _newPlayerName);
+                    showPopup("Added " + _newPlayerName + " as " + role_name(role));
                 }
                 catch (const CoupException& ex) {
-                    // for example: “Game already has 6 players”
+                    // for example: “Game is full”
                     showPopup(ex.what());
                 }
 
@@ -293,25 +293,11 @@ void GameWindow::handleMenuEvents() {
 void GameWindow::handlePlayEvents() {
     sf::Event e;
     while (_window.pollEvent(e)) {
-        // Coup‐block dialog (General)
-        if (_showBlockCoupDialog) {
+        // Reaction dialog: swallow all other clicks until the responder answers
+        if (_showReactionDialog) {
             if (e.type == sf::Event::MouseButtonPressed) {
                 sf::Vector2f m(e.mouseButton.x, e.mouseButton.y);
-                for (auto& b : _blockCoupButtons) {
-                    if (b.shape.getGlobalBounds().contains(m)) {
-                        b.onClick();
-                        break;
-                    }
-                }
-            }
-            continue;  // swallow all other clicks until choice made
-        }
-
-         // Judge's Cancel Bribe dialog
-         if (_showBlockBribeDialog) {
-            if (e.type == sf::Event::MouseButtonPressed) {
-                sf::Vector2f m(e.mouseButton.x, e.mouseButton.y);
-                for (auto& b : _blockBribeButtons) {
+                for (auto& b : _reactionButtons) {
                     if (b.shape.getGlobalBounds().contains(m)) {
                         b.onClick();
                         break;
@@ -350,12 +336,11 @@ void GameWindow::onActionClicked(const std::string& act) {
     try {
         coup::Player* cp = _game.current_player();
         if (!cp) return;
-        // Mandatory coup: if you have ≥10 coins, you must coup
-        // mandatory coup if ≥10 coins, but allow Spy peek
-        if (cp->coins() >= 10 && act != "Coup" && !(cp->role() == "Spy" && (act == "Show Coins" || act == "Hide Coins"))){
-            showPopup("Must coup when holding 10 or more coins");return;}
+        // Mandatory coup at the rules' coup_limit, but allow Spy peek
+        if (cp->coins() >= _game.rules().coup_limit && act != "Coup" && !(cp->role_id() == RoleId::Spy && (act == "Show Coins" || act == "Hide Coins"))){
+            showPopup(describe(ActionResult::MustCoup, _game.rules()));return;}
         if (act == "Gather")          { cp->gather(); }
-        else if (act == "Tax")        { cp->tax(); }
+        else if (act == "Tax")        { cp->tax(); createReactionDialog(); }
         else if (act == "Bribe") {_pending = PendingAct::Bribe;executePendingAction(nullptr);return;}
         else if (act == "Arrest")     { createTargetDialog(PendingAct::Arrest); return; }
         else if (act == "Sanction")   { createTargetDialog(PendingAct::Sanction); return; }
@@ -407,105 +392,65 @@ void GameWindow::createTargetDialog(PendingAct act) {
         y += entryH;
     }
 }
-void GameWindow::createBlockCoupDialog(coup::Player* general) {
-    _blockCoupButtons.clear();
-
-    // compute y position of that general in the side‐panel
+void GameWindow::createReactionDialog() {
+    _reactionButtons.clear();
+    _showReactionDialog = _game.in_reaction();
+    if (!_showReactionDialog) return;
+
+    // next to the responder's row in the side panel (a couped General
+    // answers from below the last row)
+    coup::Player* responder = _game.at_seat(_game.responder());
     int idx = 0;
     for (auto* p : _game.playerObjects()) {
-        if (p == general) break;
+        if (p == responder) break;
         ++idx;
     }
     float y = MENU_H + PANEL_PAD + idx * 50.f;
 
-    // “Block Coup” (red button)
+    const char* label = "Block Coup";
+    if (_game.reaction().action == ActionType::Tax)   label = "Undo Tax";
+    if (_game.reaction().action == ActionType::Bribe) label = "Cancel Bribe";
+
+    // RED: react
     {
-        auto btn = makeButton(
-            "Block Coup",
-            PANEL_PAD + PANEL_W + 20.f,
-            y,
-            [this, general]() {
-                // General pays 5
-                static_cast<General*>(general)->spend(5);
-                _game.bank() += 5;
-                // Attacker still loses 7
-                _pendingCoupAttacker->spend(7);
-                _game.bank() += 7;
-
-                showPopup(general->name() + " blocked the coup");
-                _showBlockCoupDialog = false;
-                _pending = PendingAct::None;
-            }
-        );
+        auto btn = makeButton(label, PANEL_PAD + PANEL_W + 20.f, y,
+                              [this]() { answerReaction(true); });
         btn.shape.setFillColor(sf::Color(200,  0,  0));
-        _blockCoupButtons.push_back(std::move(btn));
+        _reactionButtons.push_back(std::move(btn));
     }
 
-    // “Continue” (green button)
+    // GREEN “Continue”: let the action stand
     {
-        auto btn = makeButton(
-            "Continue",
-            PANEL_PAD + PANEL_W + 20.f + BUTTON_W + BUTTON_SP,
-            y,
-            [this]() {
-                _pendingCoupAttacker->coup(*_pendingCoupTarget);
-                showPopup(_pendingCoupAttacker->name()
-                          + " performed a coup on "
-                          + _pendingCoupTarget->name());
-                _showBlockCoupDialog = false;
-                _pending = PendingAct::None;
-            }
-        );
+        auto btn = makeButton("Continue", PANEL_PAD + PANEL_W + 20.f + BUTTON_W + BUTTON_SP, y,
+                              [this]() { answerReaction(false); });
         btn.shape.setFillColor(sf::Color(  0,200,  0));
-        _blockCoupButtons.push_back(std::move(btn));
+        _reactionButtons.push_back(std::move(btn));
     }
 }
-void GameWindow::createBlockBribeDialog(coup::Player* judge) {
-    _blockBribeButtons.clear();
-
-    // find the judge’s Y position in the side panel
-    int idx = 0;
-    for (auto* p : _game.playerObjects()) {
-        if (p == judge) break;
-        ++idx;
-    }
-    float y = MENU_H + PANEL_PAD + idx * 50.f;
 
-    // RED “Cancel Bribe”: attacker loses their 4 coins (bank gains them)
-    {
-        auto btn = makeButton(
-            "Cancel Bribe",
-            PANEL_PAD + PANEL_W + 20.f, y,
-            [this]() {
-                _pendingBribeAttacker->spend(4);
-                _game.bank() += 4;
-                showPopup(
-                    _pendingBribeAttacker->name() + "'s bribe canceled"
-                );
-                _showBlockBribeDialog = false;
-            }
-        );
-        btn.shape.setFillColor(sf::Color(200,  0,  0)); // RED
-        _blockBribeButtons.push_back(std::move(btn));
+void GameWindow::answerReaction(bool react) {
+    coup::MoveList answers;
+    _game.reaction_moves(answers);             // { reaction, Pass }
+    if (answers.empty()) {
+        _showReactionDialog = false;
+        return;
     }
-
-    // GREEN “Continue”: let the bribe stand
-    {
-        auto btn = makeButton(
-            "Continue",
-            PANEL_PAD + PANEL_W + 20.f + BUTTON_W + BUTTON_SP, y,
-            [this]() {
-                _pendingBribeAttacker->bribe();
-                showPopup(
-                    _pendingBribeAttacker->name() + " bribed for an extra action"
-                );
-                _showBlockBribeDialog = false;
-            }
-        );
-        btn.shape.setFillColor(sf::Color(  0,200,  0)); // GREEN
-        _blockBribeButtons.push_back(std::move(btn));
+    const coup::Move    m  = answers[react ? 0 : 1];
+    const coup::Reaction w = _game.reaction();
+    coup::Player*       by = _game.at_seat(m.actor);
+    const ActionResult  r  = _game.play(m);
+    if (r != ActionResult::Ok) {
+        showPopup(describe(r, _game.rules()));
+        _game.play(answers[1]);                // could not react: pass instead
+    } else if (react) {
+        const std::string& actor = _game.at_seat(w.actor)->name();
+        if      (w.action == ActionType::Tax)   showPopup(by->name() + " undid " + actor + "'s tax");
+        else if (w.action == ActionType::Bribe) showPopup(actor + "'s bribe canceled");
+        else                                    showPopup(by->name() + " blocked the coup");
     }
+    createReactionDialog();                    // the next responder, if any
 }
+
 void GameWindow::executePendingAction(coup::Player* target) {
     try {
         auto* cp = _game.current_player();
@@ -534,57 +479,19 @@ void GameWindow::executePendingAction(coup::Player* target) {
             }
 
             case PendingAct::Bribe: {
-                // validate before prompting Judge
-                try {
-                    _game.validate_turn(cp);
-                    if (_game.is_bribe_blocked(cp)) throw CoupException("Can't bribe – you are blocked");
-                    if (cp->coins() < 4)               throw CoupException("Not enough coins to bribe");
-                } catch (const CoupException& ex) {
-                    showPopup(ex.what());
-                    _pending = PendingAct::None;
-                    return;
-                }
-                // store attacker and clear pending
-                _pendingBribeAttacker = cp;
                 _pending = PendingAct::None;
-                // see if an *other* Judge can cancel
-                for (auto* p : _game.playerObjects()) {
-                    if (p->role() == "Judge" && p != cp) {
-                        createBlockBribeDialog(p);
-                        _showBlockBribeDialog = true;
-                        return;
-                    }
-                }
-                // no Judge → execute bribe now
                 cp->bribe();
                 showPopup(cp->name() + " bribed for an extra action");
+                createReactionDialog();        // another Judge may cancel it
                 return;
             }
 
             case PendingAct::Coup: {
-                // store attacker/defender, clear pending & dialog
-                auto* attacker = cp;
-                auto* defender = target;
-                _pendingCoupAttacker = attacker;
-                _pendingCoupTarget = defender;
                 _showTargetDialog = false;
                 _pending          = PendingAct::None;
-
-                // see if an *other* General can block
-                for (auto* p : _game.playerObjects()) {
-                    if (p != attacker && p->role() == "General" && p->coins() >= 5) {
-                        createBlockCoupDialog(p);
-                        _showBlockCoupDialog = true;
-                        return;
-                    }
-                }
-                // no block → manual coup
-                attacker->spend(7);
-                _game.bank() += 7;
-                _game.register_action(attacker, ActionType::Coup, defender, true);
-                _game.eliminate(defender);
-                _game.next_turn();
-                showPopup(attacker->name() + " performed a coup on " + defender->name());
+                cp->coup(*target);
+                showPopup(cp->name() + " performed a coup on " + target->name());
+                createReactionDialog();        // a General may block it
                 return;
             }
 
@@ -617,8 +524,7 @@ void GameWindow::executePendingAction(coup::Player* target) {
     } catch (const CoupException& ex) {
         // If anything throws unexpectedly, clear all dialogs & show the error
         _showTargetDialog      = false;
-        _showBlockCoupDialog   = false;
-        _showBlockBribeDialog  = false;
+        _showReactionDialog    = false;
         showPopup(ex.what());
         _pending = PendingAct::None;
     }
@@ -653,7 +559,7 @@ void GameWindow::updatePlayLayout() {
 
     // Player coins: show only for current player, or when Spy has revealed
     std::string coinStr;
-    if (isCurrent || (current->role() == "Spy" && _showSpyBalances)) {
+    if (isCurrent || (current->role_id() == RoleId::Spy && _showSpyBalances)) {
         coinStr = std::to_string(p->coins());
     }
     sf::Text coins(coinStr, _font, 18);
@@ -675,9 +581,9 @@ void GameWindow::updatePlayLayout() {
     _buttons.clear();
     if (current) {
         std::vector<std::string> acts = {"Gather","Tax","Bribe","Arrest","Sanction","Coup"};
-        if (current->role() == "Governor") acts.push_back("Block Tax");
-        if (current->role() == "Spy"){acts.push_back("Block Arrest");acts.push_back(_showSpyBalances ? "Hide Coins" : "Show Coins");}
-        if (current->role() == "Baron")    acts.push_back("Invest");
+        if (current->role_id() == RoleId::Governor) acts.push_back("Block Tax");
+        if (current->role_id() == RoleId::Spy){acts.push_back("Block Arrest");acts.push_back(_showSpyBalances ? "Hide Coins" : "Show Coins");}
+        if (current->role_id() == RoleId::Baron)    acts.push_back("Invest");
         float totalW = acts.size()*BUTTON_W + (acts.size()-1)*BUTTON_SP;
         float startX = (WIN_W - totalW) / 2.f;
         for (size_t i = 0; i < acts.size(); ++i) {
@@ -727,24 +633,15 @@ void GameWindow::drawPlay() {
         }
     }
 
-    // Block-Coup or block-Bribe overlays
-    if (_showBlockCoupDialog) {
-        for (auto& b : _blockCoupButtons) {
-            _window.draw(b.shape);
-            _window.draw(b.label);
-        }
-        _window.display();
-        return;
-    }
-    if (_showBlockBribeDialog) {
-        for (auto& b : _blockBribeButtons) {
+    // Reaction overlay
+    if (_showReactionDialog) {
+        for (auto& b : _reactionButtons) {
             _window.draw(b.shape);
             _window.draw(b.label);
         }
         _window.display();
         return;
     }
-
     // Draw in-game pop-ups *under* the bank coin:
     if (_popupMessage) {
         if (_popupClock.getElapsedTime().asSeconds() < 2.f) {
@@ -810,14 +707,9 @@ void GameWindow::drawMenu() {
         Button btn = makeButton(
             "Change Role", PANEL_PAD + 300.f, y - 4.f,
             [this, p]() {
-                static const std::vector<std::string> ALL = {
-                    "Governor","Spy","Baron","General","Judge","Merchant"
-                };
-                static std::mt19937 rng(std::random_device{}());
-                std::uniform_int_distribution<size_t> dist(0, ALL.size()-1);
-                std::string newRole = ALL[dist(rng)];
+                RoleId newRole = static_cast<RoleId>(_rng.below(ROLE_COUNT));
                 p->change_role(newRole);
-                showPopup(p->name() + " is now a " + newRole);
+                showPopup(p->name() + " is now a " + role_name(newRole));
             }
         );
         _roleButtons.push_back(btn);
@@ -853,4 +745,12 @@ GameWindow::Button GameWindow::makeButton(const std::string& txt, float x, float
 void GameWindow::showPopup(const std::string& msg) {
     _popupMessage = msg;
     _popupClock.restart();
-}
\ No newline at end of file
+}
+void GameWindow::syncLog(std::size_t maxLines) {
+    // Only entries logged since the last frame are formatted
+    for (const coup::LogEntry& e : _game.log_since(_logSeq)) {
+        _logLines.push_back(_game.format(e));
+        if (_logLines.size() > maxLines) _logLines.pop_front();
+    }
+    _logSeq = _game.log_seq();
+}
@@ -5,24 +5,35 @@
 namespace coup {
 
 Baron::Baron(Game& game, const std::string& name)
-    : Player(game, name) {_roleName = "Baron";}
+    : Player(game, name, RoleId::Baron) {}
     void Baron::invest() {
-        _game.validate_turn(this);
-        if (_coins < 3) {
-            COUP_THROW("Not enough coins to invest");
+        ActionResult r = try_invest();
+        if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+    }
+
+    ActionResult Baron::can_invest() const noexcept {
+        if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+        if (_coins < _game.rules().invest_cost) {
+            return ActionResult::InsufficientCoins;
         }
-        // Pay 3 into the bank
-        spend(3);
-        // Gain 6 from the bank
-        gain(6);
+        return ActionResult::Ok;
+    }
+
+    ActionResult Baron::try_invest() {
+        if (ActionResult r = can_invest(); r != ActionResult::Ok) return r;
+        // Pay into the bank
+        _coins -= _game.rules().invest_cost;
+        // Gain more back from the bank
+        gain(_game.rules().invest_gain);
     
         // Record & advance
         _game.register_action(this, ActionType::Invest, nullptr, true);
-        _game.next_turn();
+        finish_action();
+        return ActionResult::Ok;
     }
 
 void Baron::on_sanction(Player&) {
     gain(1);   // compensation coin
 }
 
-} // namespace coup
\ No newline at end of file
+} // namespace coup
@@ -6,21 +6,29 @@
 
 namespace coup {
 
-General::General(Game& game, const std::string& name) : Player(game, name) {_roleName = "General";}
+General::General(Game& game, const std::string& name) : Player(game, name, RoleId::General) {}
 
 void General::block_coup(Player& target) {
-    
-    if (_coins < 5) {
-        COUP_THROW("Not enough coins to block a coup");
+    ActionResult r = try_block_coup(target);
+    if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+}
+
+ActionResult General::try_block_coup(Player& target) {
+    if (_coins < _game.rules().block_coup_cost) {
+        return ActionResult::InsufficientCoins;
+    }
+    if (!_game.last_coup(&target)) {
+        return ActionResult::NothingToUndo;
     }
-    // pay 5 to the bank
-    spend(5);
+    // pay the block cost to the bank
+    _coins -= _game.rules().block_coup_cost;
     // undo the coup (restores target & returns their card)
     _game.cancel_coup(&target);
 
     // record & advance
     _game.register_action(this, ActionType::BlockCoup, &target, true);
     _game.next_turn();
+    return ActionResult::Ok;
 }
 
 void General::on_arrest_refund() {
@@ -6,39 +6,54 @@
 
 namespace coup {
 
-Governor::Governor(Game& game, const std::string& name) : Player(game, name) {_roleName = "Governor";}
+Governor::Governor(Game& game, const std::string& name) : Player(game, name, RoleId::Governor) {}
 
-void Governor::tax() {
-    _game.validate_turn(this);
-    if (_coins >= MANDATORY_COUP_LIMIT) {
-        COUP_THROW("Must coup when holding 10 or more coins");
-    }
-    _game.register_action(this, ActionType::Tax);          
-    gain(3);
-    _game.bank() -= 3;
+ActionResult Governor::try_tax() {
+    if (ActionResult r = can_tax(); r != ActionResult::Ok) return r;
+
+    gain(_game.rules().governor_tax_gain);
+    _game.bank() -= _game.rules().governor_tax_gain;
     _game.register_action(this, ActionType::Tax, nullptr, true);
-    _game.next_turn();
+    finish_action();
+    return ActionResult::Ok;
 }
 
-void Governor::undo(Player& action_owner) {
-   
+ActionResult Governor::try_undo(Player& action_owner) {
     auto rec = _game.last_action(&action_owner, ActionType::Tax);
     if (!rec) {
-        COUP_THROW("No tax action to undo");
+        return ActionResult::NothingToUndo;
+    }
+    const int refund = _game.rules().tax_gain;
+    if (action_owner.coins() < refund) {
+        return ActionResult::InsufficientCoins;
     }
 
-    action_owner.spend(2);
-    _game.bank() += 2;
+    action_owner.spend(refund);
+    _game.bank() += refund;
+    return ActionResult::Ok;
 }
+
 void Governor::block_tax(Player& target) {
-    _game.validate_turn(this);
+    ActionResult r = try_block_tax(target);
+    if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+}
+
+ActionResult Governor::can_block_tax(const Player& target) const noexcept {
+    if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+    if (&target == this || !_game.has_player(&target)) return ActionResult::InvalidTarget;
     if (_game.is_tax_blocked(&target)) {
-        COUP_THROW("Already blocked tax for " + target.name());
+        return ActionResult::AlreadyBlocked;
     }
+    return ActionResult::Ok;
+}
+
+ActionResult Governor::try_block_tax(Player& target) {
+    if (ActionResult r = can_block_tax(target); r != ActionResult::Ok) return r;
     // Register the block
     _game.block_tax(&target);
     _game.register_action(this, ActionType::TaxCancel, &target, true);
     // Advance turn
-    _game.next_turn();
+    finish_action();
+    return ActionResult::Ok;
 }
-} // namespace coup
\ No newline at end of file
+} // namespace coup
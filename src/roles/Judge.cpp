@@ -5,24 +5,31 @@
 namespace coup {
 
 Judge::Judge(Game& game, const std::string& name)
-    : Player(game, name) {_roleName = "Judge";}
+    : Player(game, name, RoleId::Judge) {}
 
     void Judge::cancel_bribe(Player& target) {
-        _game.validate_turn(this);
+        ActionResult r = try_cancel_bribe(target);
+        if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+    }
+
+    ActionResult Judge::can_cancel_bribe(const Player& target) const noexcept {
+        if (ActionResult r = _game.check_turn(this); r != ActionResult::Ok) return r;
+        if (&target == this || !_game.has_player(&target)) return ActionResult::InvalidTarget;
         if (_game.is_bribe_blocked(&target)) {
-            COUP_THROW("Already blocked bribe for " + target.name());
+            return ActionResult::AlreadyBlocked;
         }
+        return ActionResult::Ok;
+    }
+
+    ActionResult Judge::try_cancel_bribe(Player& target) {
+        if (ActionResult r = can_cancel_bribe(target); r != ActionResult::Ok) return r;
         // Register the block
         _game.block_bribe(&target);
         // Log it
         _game.register_action(this, ActionType::BribeCancel, &target, true);
         // Advance turn
-        _game.next_turn();
+        finish_action();
+        return ActionResult::Ok;
     }
 
-void Judge::on_sanction(Player& attacker) {
-    attacker.spend(1);
-    _game.bank() += 1;
-}
-
 } // namespace coup
\ No newline at end of file
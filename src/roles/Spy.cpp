@@ -6,14 +6,30 @@
 
 namespace coup {
 
-Spy::Spy(Game& game, const std::string& name) : Player(game, name) {_roleName = "Spy";}
+Spy::Spy(Game& game, const std::string& name) : Player(game, name, RoleId::Spy) {}
 
 int Spy::inspect(const Player& target) const noexcept {
     return target.coins();
 }
 
 void Spy::block_arrest(Player& target) {
+    ActionResult r = try_block_arrest(target);
+    if (r != ActionResult::Ok) throw CoupException{r, _game.rules()};
+}
+
+ActionResult Spy::can_block_arrest(const Player& target) const noexcept {
+    // free at any time, except while a reaction window waits for its answer
+    if (_game.in_reaction())                           return ActionResult::NotYourTurn;
+    if (&target == this || !_game.has_player(&target)) return ActionResult::InvalidTarget;
+    if (_game.is_arrest_blocked(&target))              return ActionResult::AlreadyBlocked;
+    return ActionResult::Ok;
+}
+
+ActionResult Spy::try_block_arrest(Player& target) {
+    if (ActionResult r = can_block_arrest(target); r != ActionResult::Ok) return r;
     _game.block_arrest(&target);
+    _game.register_action(this, ActionType::ArrestBlock, &target, true);
+    return ActionResult::Ok;
 }
 
 }
@@ -0,0 +1,226 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Async.hpp"
+#include "Player.hpp"
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <latch>
+
+namespace coup_sim {
+
+using coup::ActionResult;
+using coup::ActionType;
+using coup::Game;
+using coup::Move;
+
+// ───────────────── Seat ─────────────────
+
+void Seat::attach(AgentTask agent) noexcept {
+    _task     = std::move(agent);
+    _task._h.promise().seat = this;
+    _agent    = _task._h;
+    _engine   = {};
+    _decision = nullptr;
+    _answer.reset();
+    _fresh    = false;
+}
+
+void Seat::finish() noexcept {
+    if (_agent) {
+        _decision = nullptr;
+        _fresh    = true;
+        _engine   = {};
+        _handoff.store(false, std::memory_order_relaxed);
+        _agent.resume();   // runs to its end (or its next next()) on this thread
+    }
+    _task  = AgentTask{};
+    _agent = {};
+}
+
+// ───────────────── Scheduler ─────────────────
+
+Scheduler::Scheduler(std::size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    _pool.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        _pool.emplace_back([this](std::stop_token stop) { worker(stop); });
+    }
+}
+
+void Scheduler::post(std::coroutine_handle<> h) {
+    {
+        std::lock_guard lock(_mutex);
+        _ready.push_back(h);
+    }
+    _ready_cv.notify_one();
+}
+
+void Scheduler::worker(std::stop_token stop) {
+    for (;;) {
+        std::coroutine_handle<> h;
+        {
+            std::unique_lock lock(_mutex);
+            if (!_ready_cv.wait(lock, stop, [&] { return !_ready.empty(); })) return;
+            h = _ready.front();
+            _ready.pop_front();
+        }
+        h.resume();
+    }
+}
+
+// ───────────────── Agents ─────────────────
+
+AgentTask random_agent(Seat& seat, coup::Rng rng) {
+    while (const Decision* d = co_await seat.next()) {
+        if (d->reaction) {
+            seat.play(random_reacts(d->moves[0], rng) ? d->moves[0] : d->moves[1]);
+        } else {
+            seat.play(random_move(*d->game, d->moves, rng));
+        }
+    }
+}
+
+AgentTask greedy_agent(Seat& seat) {
+    while (const Decision* d = co_await seat.next()) {
+        if (d->reaction) {
+            seat.play(greedy_reacts(d->moves[0]) ? d->moves[0] : d->moves[1]);
+        } else {
+            seat.play(greedy_move(*d->game, d->moves));
+        }
+    }
+}
+
+// ───────────────── Driver ─────────────────
+
+namespace {
+
+struct Shared {
+    const AsyncConfig&         cfg;
+    const AgentFactory&        make;
+    Scheduler*                 pool = nullptr;
+    std::atomic<std::uint64_t> next{0};
+    std::latch                 done;
+    std::mutex                 error_mutex;
+    std::exception_ptr         error;
+};
+
+// Fire-and-forget coroutine: started by Scheduler::post, frees itself at the end
+struct Lane {
+    struct promise_type {
+        Lane get_return_object() noexcept {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_never  final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }   // the body catches
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+// One driver: plays games until the batch is exhausted, reusing its Game
+// and seats as Simulator does, then counts the latch down.
+Lane lane(Shared& sh, SimStats& stats) {
+    const SimConfig& cfg = sh.cfg.sim;
+    Game                                      game(cfg.rules);
+    std::array<Seat, Game::MAX_PLAYERS>      seats;
+    Decision                                  d;
+    d.game = &game;
+    for (std::uint8_t s = 0; s < seats.size(); ++s) seats[s].place(s, sh.pool);
+    try {
+        for (std::uint64_t id; (id = sh.next.fetch_add(1, std::memory_order_relaxed)) < cfg.games;) {
+            coup::Rng table = coup::Rng::stream(cfg.seed, id, coup::TABLE_STREAM);
+            game.reset();
+            game.set_logging(false);
+            deal(game, cfg, table, stats);
+            for (std::uint8_t s = 0; s < cfg.players; ++s) {
+                seats[s].attach(sh.make(seats[s], id));
+            }
+
+            std::size_t turns = 0;
+            while (game.alive_count() > 1 && turns < cfg.max_turns) {
+                const coup::Player* cp = game.current_player();
+                game.legal_moves(d.moves);
+                if (d.moves.empty()) {
+                    game.next_turn();   // nothing legal: forfeit, nobody is asked
+                } else {
+                    d.seat     = cp->seat();
+                    d.reaction = false;
+                    const std::optional<Move> m = co_await seats[d.seat].decide(d);
+                    if (!m || game.play(*m) != ActionResult::Ok) {
+                        ++stats.illegal;
+                        game.next_turn();
+                    } else {
+                        ++stats.actions;
+                    }
+                    while (game.in_reaction()) {
+                        d.seat     = game.responder();
+                        d.reaction = true;
+                        game.reaction_moves(d.moves);
+                        const std::optional<Move> r = co_await seats[d.seat].decide(d);
+                        if (r && game.play(*r) == ActionResult::Ok) {
+                            stats.actions += r->type != ActionType::Pass;
+                        } else {
+                            ++stats.illegal;
+                            game.play(d.moves[1]);
+                        }
+                    }
+                }
+                if (game.current_player() != cp) ++turns;
+            }
+            for (std::uint8_t s = 0; s < cfg.players; ++s) seats[s].finish();
+            tally(game, turns, stats);
+        }
+    } catch (...) {
+        std::lock_guard lock(sh.error_mutex);
+        if (!sh.error) sh.error = std::current_exception();
+        sh.next.store(cfg.games);   // stop the other lanes after their game
+    }
+    sh.done.count_down();
+}
+
+} // namespace
+
+SimStats run_async(const AsyncConfig& cfg, const AgentFactory& make) {
+    Simulator{cfg.sim};   // reject bad settings before any lane starts
+    const std::size_t lanes =
+        std::max<std::size_t>(1, std::min<std::uint64_t>(cfg.lanes, cfg.sim.games));
+
+    std::vector<SimStats> per(lanes);
+    Shared sh{cfg, make, nullptr, {}, std::latch(static_cast<std::ptrdiff_t>(lanes)), {}, {}};
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+        Scheduler pool(cfg.threads);
+        sh.pool = &pool;
+        for (std::size_t l = 0; l < lanes; ++l) pool.post(lane(sh, per[l]).handle);
+        sh.done.wait();
+    }   // joins the threads, so every lane frame is gone before sh and per
+    if (sh.error) std::rethrow_exception(sh.error);
+
+    SimStats out;
+    for (const SimStats& s : per) out.merge(s);
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return out;
+}
+
+SimStats run_async(const AsyncConfig& cfg) {
+    const SimConfig& sim = cfg.sim;
+    switch (sim.policy) {
+        case PolicyKind::Random:
+            return run_async(cfg, [&sim](Seat& seat, std::uint64_t game) {
+                return random_agent(seat, coup::Rng::stream(sim.seed, game, seat.index()));
+            });
+        case PolicyKind::Greedy:
+            return run_async(cfg, [](Seat& seat, std::uint64_t) { return greedy_agent(seat); });
+        case PolicyKind::Mcts:
+        case PolicyKind::Agent:
+        case PolicyKind::Ismcts:
+            break;
+    }
+    COUP_THROW("Coroutine agents cover the random and greedy policies");
+}
+
+} // namespace coup_sim
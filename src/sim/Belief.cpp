@@ -0,0 +1,217 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Belief.hpp"
+
+#include "Game.hpp"
+#include "Player.hpp"
+#include "exceptions.hpp"
+#include "roles/Spy.hpp"
+
+namespace coup_sim {
+
+using coup::ActionType;
+using coup::RoleId;
+
+namespace {
+
+constexpr int TOP = static_cast<int>(BELIEF_COINS) - 1;
+
+constexpr std::size_t bin(int c) noexcept {
+    return static_cast<std::size_t>(std::clamp(c, 0, TOP));
+}
+
+} // namespace
+
+// ───────────────── Log events ─────────────────
+
+CoinEffect coin_effect(ActionType type, RoleId actor, RoleId target, const coup::RuleSet& rs) noexcept {
+    CoinEffect e;
+    switch (type) {
+        case ActionType::Gather:
+            // a Merchant's start-of-turn coin is logged as a Gather too
+            if (actor != RoleId::Merchant) e.actor_below = rs.coup_limit;
+            e.actor_gain = 1;
+            break;
+        case ActionType::Tax:
+            e.actor_below = rs.coup_limit;
+            e.actor_gain  = actor == RoleId::Governor ? rs.governor_tax_gain : rs.tax_gain;
+            break;
+        case ActionType::Bribe:
+            e.actor_below = rs.coup_limit;
+            e.actor_needs = rs.bribe_cost;
+            e.actor_gain  = -rs.bribe_cost;
+            break;
+        case ActionType::Arrest:
+            e.targeted     = true;
+            e.target_needs = 1;
+            if (target == RoleId::General) {           // takes the coin back
+                e.actor_gain = 1;
+            } else if (target == RoleId::Merchant) {   // pays 2 to the bank instead
+                e.target_gain = -2;
+            } else {
+                e.actor_gain  = 1;
+                e.target_gain = -1;
+            }
+            break;
+        case ActionType::Sanction:
+            e.targeted    = true;
+            e.actor_needs = rs.sanction_price(target == RoleId::Judge);
+            e.actor_gain  = -e.actor_needs;
+            if (target == RoleId::Baron) e.target_gain = 1;
+            break;
+        case ActionType::Coup:
+            e.actor_needs = rs.coup_cost;
+            e.actor_gain  = -rs.coup_cost;
+            break;
+        case ActionType::Invest:
+            e.actor_needs = rs.invest_cost;
+            e.actor_gain  = rs.invest_gain - rs.invest_cost;
+            break;
+        case ActionType::BlockCoup:
+            e.actor_needs = rs.block_coup_cost;
+            e.actor_gain  = -rs.block_coup_cost;
+            break;
+        case ActionType::TaxUndo:
+            e.targeted     = true;
+            e.target_needs = rs.tax_gain;
+            e.target_gain  = -rs.tax_gain;
+            break;
+        default:
+            break;   // blocks and cancels move no coins
+    }
+    return e;
+}
+
+// ───────────────── Distributions ─────────────────
+
+CoinDist CoinDist::exact(int c) noexcept {
+    CoinDist d;
+    d._p[0]      = 0.0f;
+    d._p[bin(c)] = 1.0f;
+    return d;
+}
+
+CoinDist CoinDist::uniform(CoinRange r) noexcept {
+    CoinDist d;
+    d._p[0] = 0.0f;
+    const std::size_t lo = bin(r.lo), hi = bin(r.hi);
+    for (std::size_t c = lo; c <= hi; ++c) d._p[c] = 1.0f / static_cast<float>(hi - lo + 1);
+    return d;
+}
+
+CoinRange CoinDist::range() const noexcept {
+    std::size_t lo = 0, hi = TOP;
+    while (lo < static_cast<std::size_t>(TOP) && _p[lo] <= 0.0f) ++lo;
+    while (hi > lo && _p[hi] <= 0.0f) --hi;
+    return {static_cast<std::uint8_t>(lo), static_cast<std::uint8_t>(hi)};
+}
+
+double CoinDist::mean() const noexcept {
+    double m = 0.0;
+    for (std::size_t c = 0; c < BELIEF_COINS; ++c) m += static_cast<double>(c) * _p[c];
+    return m;
+}
+
+int CoinDist::sample(coup::Rng& rng) const noexcept {
+    float total = 0.0f;
+    for (float p : _p) total += p;
+    float u = static_cast<float>(rng() >> 40) * 0x1.0p-24f * total;
+    int   last = 0;
+    for (int c = 0; c <= TOP; ++c) {
+        if (_p[c] <= 0.0f) continue;
+        last = c;
+        u -= _p[c];
+        if (u < 0.0f) return c;
+    }
+    return last;   // rounding ran past the end
+}
+
+void CoinDist::shift(int d) noexcept {
+    if (d == 0) return;
+    std::array<float, BELIEF_COINS> out{};
+    for (int c = 0; c <= TOP; ++c) out[bin(c + d)] += _p[c];
+    _p = out;
+}
+
+void CoinDist::at_least(int c) noexcept { keep(c, TOP, c); }
+void CoinDist::below(int c) noexcept    { keep(0, c - 1, c - 1); }
+
+void CoinDist::keep(int lo, int hi, int fallback) noexcept {
+    float total = 0.0f;
+    for (int c = 0; c <= TOP; ++c) {
+        if (c < lo || c > hi) _p[c] = 0.0f;
+        total += _p[c];
+    }
+    if (total <= 0.0f) {
+        *this = exact(fallback);
+        return;
+    }
+    for (float& p : _p) p /= total;
+}
+
+// ───────────────── Tracker ─────────────────
+
+CoinTracker::CoinTracker(const coup::Game& game, std::size_t observer, std::uint64_t since)
+    : _game(&game), _observer(observer), _epoch(game.epoch()),
+      _seq(std::max(since, game.log_start())) {
+    if (_seq > game.log_start()) {
+        const CoinDist unknown = CoinDist::uniform({0, static_cast<std::uint8_t>(
+                                                        bin(2 * game.rules().coup_limit))});
+        _beliefs.fill(unknown);
+    }
+    sync_observer();
+}
+
+std::size_t CoinTracker::update() {
+    const coup::Game&     g   = *_game;
+    const coup::RuleSet&  rs  = g.rules();
+    const std::size_t     end = g.seat_count();
+    if (g.epoch() != _epoch) {
+        COUP_THROW("CoinTracker follows one match; the game was reset");
+    }
+    // log id → seat, over at most MAX_SEATS seats (ids of players who left are skipped)
+    auto seat_of = [&](std::uint8_t id) -> std::size_t {
+        if (id == coup::NO_SEAT) return coup::NO_SEAT;
+        for (std::size_t s = 0; s < end; ++s) {
+            if (g.player_id(s) == id) return s;
+        }
+        return coup::NO_SEAT;
+    };
+
+    const auto entries = g.log_since(_seq);
+    for (const coup::LogEntry& e : entries) {
+        if (!e.success) continue;
+        const std::size_t a = seat_of(e.actor);
+        if (a == coup::NO_SEAT) continue;
+        const std::size_t t      = seat_of(e.target);
+        const bool        hasT   = t != coup::NO_SEAT;
+        const RoleId      target = hasT ? g.at_seat(t)->role_id() : RoleId::Governor;
+        const CoinEffect  fx     = coin_effect(e.type, g.at_seat(a)->role_id(), target, rs);
+        if (fx.targeted && !hasT) continue;
+        fx.apply(_beliefs[a], hasT ? &_beliefs[t] : nullptr);
+    }
+    _seq += entries.size();
+    sync_observer();
+    return entries.size();
+}
+
+void CoinTracker::observe(std::size_t s, int coins) noexcept {
+    _beliefs[s] = CoinDist::exact(coins);
+}
+
+void CoinTracker::inspect(const coup::Spy& spy, std::size_t s) {
+    const coup::Player* p = _game->at_seat(s);
+    if (!p) COUP_THROW("No player at that seat");
+    observe(s, spy.inspect(*p));
+}
+
+CoinBounds CoinTracker::bounds() const noexcept {
+    CoinBounds b;
+    for (std::size_t s = 0; s < b.size(); ++s) b[s] = _beliefs[s].range();
+    return b;
+}
+
+void CoinTracker::sync_observer() noexcept {
+    if (const coup::Player* me = _game->at_seat(_observer)) _beliefs[_observer] = CoinDist::exact(me->coins());
+}
+
+} // namespace coup_sim
@@ -0,0 +1,184 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Ismcts.hpp"
+
+#include "Game.hpp"
+#include "Player.hpp"
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coup_sim {
+
+using coup::ActionType;
+using coup::GameState;
+using coup::Move;
+using coup::MoveList;
+using coup::RoleId;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+// ───────────────── Bounds ─────────────────
+
+CoinBounds coin_bounds(const coup::Game& game, std::size_t observer, std::size_t memory) {
+    const coup::RuleSet& rs = game.rules();
+    const std::vector<coup::LogEntry>& log = game.log_entries();
+    const std::size_t first = memory == 0 || memory >= log.size() ? 0 : log.size() - memory;
+
+    CoinBounds b;
+    b.fill(first == 0 ? CoinRange{} : CoinRange{0, CoinRange::exact(2 * rs.coup_limit).hi});
+
+    // log ids → seats and roles (ids of players no longer seated are skipped)
+    std::array<std::uint8_t, 256> seat_of;
+    seat_of.fill(coup::NO_SEAT);
+    std::array<RoleId, GameState::MAX_SEATS> role{};
+    for (std::size_t s = 0; s < game.seat_count(); ++s) {
+        if (const coup::Player* p = game.at_seat(s)) {
+            seat_of[game.player_id(s)] = static_cast<std::uint8_t>(s);
+            role[s] = p->role_id();
+        }
+    }
+
+    for (std::size_t i = first; i < log.size(); ++i) {
+        const coup::LogEntry& e = log[i];
+        const std::uint8_t a = seat_of[e.actor];
+        if (!e.success || a == coup::NO_SEAT) continue;
+        const std::uint8_t t    = e.target == coup::NO_SEAT ? coup::NO_SEAT : seat_of[e.target];
+        const bool         hasT = t != coup::NO_SEAT;
+        const CoinEffect   fx   = coin_effect(e.type, role[a], hasT ? role[t] : RoleId::Governor, rs);
+        if (fx.targeted && !hasT) continue;
+        fx.apply(b[a], hasT ? &b[t] : nullptr);
+    }
+
+    if (const coup::Player* me = game.at_seat(observer)) b[observer] = CoinRange::exact(me->coins());
+    return b;
+}
+
+GameState determinize(const GameState& state, const CoinBounds& bounds, std::size_t observer,
+                      coup::Rng& rng) {
+    GameState w = state;
+    for (std::size_t s = 0; s < w.seats; ++s) {
+        if (s == observer || !w.is_alive(s)) continue;
+        const CoinRange r = bounds[s];
+        w.coins[s] = static_cast<std::uint8_t>(r.lo + rng.below(static_cast<std::uint64_t>(r.width())));
+    }
+    w.rehash();
+    return w;
+}
+
+GameState determinize(const GameState& state, const CoinBeliefs& beliefs, std::size_t observer,
+                      coup::Rng& rng) {
+    GameState w = state;
+    for (std::size_t s = 0; s < w.seats; ++s) {
+        if (s == observer || !w.is_alive(s)) continue;
+        w.coins[s] = static_cast<std::uint8_t>(beliefs[s].sample(rng));
+    }
+    w.rehash();
+    return w;
+}
+
+// ───────────────── Search ─────────────────
+
+IsmctsBot::IsmctsBot(const IsmctsConfig& cfg) : _cfg(cfg) {
+    if (_cfg.threads == 0) _cfg.threads = std::thread::hardware_concurrency();
+    if (_cfg.threads == 0) _cfg.threads = 1;
+    if (_cfg.worlds == 0) _cfg.worlds = 1;
+    _cfg.search.threads = 1;
+}
+
+Move IsmctsBot::choose(const coup::Game& game) {
+    if (game.in_reaction()) {
+        COUP_THROW("IsmctsBot::choose(Game) plays turns; answer a reaction on its GameState");
+    }
+    const coup::Player* cp = game.current_player();
+    if (!cp) COUP_THROW("No player to move");
+    return choose(GameState::from(game), coin_bounds(game, cp->seat(), _cfg.memory));
+}
+
+Move IsmctsBot::choose(const GameState& state, const CoinBounds& bounds) {
+    return search(state, [&](coup::Rng& rng) { return determinize(state, bounds, state.to_move(), rng); });
+}
+
+Move IsmctsBot::choose(const GameState& state, const CoinBeliefs& beliefs) {
+    return search(state, [&](coup::Rng& rng) { return determinize(state, beliefs, state.to_move(), rng); });
+}
+
+template <class Draw>
+Move IsmctsBot::search(const GameState& state, const Draw& draw) {
+    const auto t0 = Clock::now();
+    _last = IsmctsReport{};
+
+    MoveList root;
+    state.legal_moves(root);
+    if (root.size() <= 1) {
+        _last.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        return root.empty() ? Move{ActionType::Pass, state.to_move(), coup::NO_SEAT} : root[0];
+    }
+
+    const bool          timed   = _cfg.time_ms > 0.0;
+    const auto          budget  = std::chrono::duration<double, std::milli>(_cfg.time_ms);
+    const auto          end     = t0 + std::chrono::duration_cast<Clock::duration>(budget);
+    const std::uint64_t call    = _calls++;
+    std::atomic<std::size_t> next{0};
+
+    std::vector<std::uint32_t> visits(root.size(), 0);
+    std::mutex                 merge;
+
+    auto work = [&] {
+        std::vector<std::uint32_t> mine(root.size(), 0);
+        std::size_t worlds = 0, iterations = 0;
+        for (;;) {
+            const auto now = Clock::now();
+            if (timed && worlds > 0 && now >= end) break;
+            const std::size_t w = next.fetch_add(1, std::memory_order_relaxed);
+            if (!timed && w >= _cfg.worlds) break;
+
+            // world w draws from its own stream, whichever thread searches it
+            coup::Rng  rng = coup::Rng::stream(_cfg.seed, call, w);
+            MctsConfig mc  = _cfg.search;
+            mc.seed        = rng();
+            if (timed) {
+                mc.time_ms = std::max(std::chrono::duration<double, std::milli>(end - now).count(), 0.001);
+                if (_cfg.search.time_ms > 0.0) mc.time_ms = std::min(mc.time_ms, _cfg.search.time_ms);
+            }
+            MctsBot bot(mc);
+            bot.choose(draw(rng));
+
+            // same moves in any world but the arrests a drawn 0 rules out
+            const MoveList& moves = bot.last_moves();
+            for (std::size_t i = 0; i < moves.size(); ++i) {
+                const Move* at = std::find(root.begin(), root.end(), moves[i]);
+                if (at != root.end()) mine[static_cast<std::size_t>(at - root.begin())] += bot.last_visits()[i];
+            }
+            ++worlds;
+            iterations += bot.last().iterations;
+        }
+        std::lock_guard lock(merge);
+        for (std::size_t i = 0; i < visits.size(); ++i) visits[i] += mine[i];
+        _last.worlds     += worlds;
+        _last.iterations += iterations;
+    };
+    {
+        std::vector<std::jthread> pool;
+        for (std::size_t k = 1; k < _cfg.threads; ++k) pool.emplace_back(work);
+        work();
+    }
+
+    // most visited root move; ties keep generation order
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < root.size(); ++i) {
+        if (visits[i] > visits[best]) best = i;
+    }
+    _last.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    return root[best];
+}
+
+} // namespace coup_sim
@@ -0,0 +1,271 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Mcts.hpp"
+
+#include "Game.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <thread>
+
+namespace coup_sim {
+
+using coup::ActionType;
+using coup::GameState;
+using coup::Move;
+using coup::MoveList;
+
+namespace {
+
+constexpr std::size_t MAX_DEPTH = 128;   // guards against transposition cycles
+
+} // namespace
+
+// ───────────────── Tree ─────────────────
+
+void MctsBot::Tree::reset(const GameState& root, std::size_t reserve) {
+    nodes.clear();
+    edges.clear();
+    table.clear();
+    tt_hits = 0;
+    nodes.reserve(reserve);
+    edges.reserve(reserve * 8);
+    add(root, false);
+}
+
+std::uint32_t MctsBot::Tree::add(const GameState& s, bool share) {
+    const std::uint64_t h = s.hash();
+    if (share) {
+        auto it = table.find(h);
+        if (it != table.end() && nodes[it->second].state == s) {
+            ++tt_hits;
+            return it->second;
+        }
+    }
+
+    Node n;
+    n.state      = s;
+    n.first_edge = static_cast<std::uint32_t>(edges.size());
+    MoveList ml;
+    s.legal_moves(ml);
+    for (const Move& m : ml) edges.push_back({m, NONE});
+    n.edges = static_cast<std::uint8_t>(ml.size());
+
+    const auto idx = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(n);
+    if (share) table.emplace(h, idx);
+    return idx;
+}
+
+// ───────────────── Search steps ─────────────────
+
+std::uint32_t MctsBot::select(Tree& t, std::vector<std::uint32_t>& path) const {
+    path.clear();
+    std::uint32_t idx = 0;
+    for (std::size_t depth = 0; depth < MAX_DEPTH; ++depth) {
+        path.push_back(idx);
+        const Node& n = t.nodes[idx];
+        if (n.edges == 0) return idx;                 // terminal
+
+        if (n.expanded < n.edges) {
+            if (t.nodes.size() >= _cfg.max_nodes) return idx;   // tree full: play out here
+            const std::uint32_t e = n.first_edge + n.expanded;
+            GameState child = n.state;
+            child.apply(t.edges[e].move);
+            // add() may reallocate, so `n` is not used past this point
+            const std::uint32_t c = t.add(child, _cfg.transpositions);
+            t.edges[e].child = c;
+            ++t.nodes[idx].expanded;
+            path.push_back(c);
+            return c;
+        }
+        idx = best_child(t, n);
+    }
+    return idx;
+}
+
+std::uint32_t MctsBot::best_child(const Tree& t, const Node& n) const {
+    const std::uint8_t mover = n.state.to_move();
+    const double logN = std::log(static_cast<double>(std::max<std::uint32_t>(n.visits, 1)));
+    std::uint32_t best = NONE;
+    double bestScore = -1.0;
+    for (std::uint32_t e = n.first_edge; e < n.first_edge + n.edges; ++e) {
+        const std::uint32_t c = t.edges[e].child;
+        const Node& ch = t.nodes[c];
+        if (ch.visits == 0) return c;
+        const double mean = ch.value[mover] / ch.visits;
+        const double uct  = mean + _cfg.exploration * std::sqrt(logN / ch.visits);
+        if (uct > bestScore) { bestScore = uct; best = c; }
+    }
+    return best;
+}
+
+void MctsBot::backprop(Tree& t, const std::vector<std::uint32_t>& path,
+                       const Rewards& r, std::uint32_t visits) {
+    for (std::uint32_t idx : path) {
+        Node& n = t.nodes[idx];
+        n.visits += visits;
+        for (std::size_t s = 0; s < r.size(); ++s) n.value[s] += r[s];
+    }
+}
+
+MctsBot::Rewards MctsBot::score(const GameState& s) {
+    Rewards r{};
+    const std::uint8_t w = s.winner();
+    if (w != coup::NO_SEAT) {
+        r[w] = 1.0f;
+        return r;
+    }
+    // unfinished playout: split the win between the survivors
+    const float share = 1.0f / static_cast<float>(std::max(1, s.alive_count()));
+    for (std::size_t i = 0; i < s.seats; ++i) {
+        if (s.is_alive(i)) r[i] = share;
+    }
+    return r;
+}
+
+MctsBot::Rewards MctsBot::rollout(GameState s, Rng& rng) const {
+    // one branch per playout, the moves inside are decided inline
+    with_agent(_cfg.rollout, [&](auto agent) { playout(s, agent, rng, _cfg.rollout_cap); });
+    return score(s);
+}
+
+bool MctsBot::out_of_time() const noexcept {
+    return _cfg.time_ms > 0.0 && Clock::now() >= _deadline;
+}
+
+// ───────────────── Parallel drivers ─────────────────
+
+std::size_t MctsBot::search_root(Tree& t, Rng& rng, std::size_t budget) const {
+    std::vector<std::uint32_t> path;
+    path.reserve(MAX_DEPTH + 1);
+    std::size_t i = 0;
+    for (; i < budget; ++i) {
+        if ((i & 31) == 0 && out_of_time()) break;
+        const std::uint32_t leaf = select(t, path);
+        backprop(t, path, rollout(t.nodes[leaf].state, rng), 1);
+    }
+    return i;
+}
+
+// One shared tree: the calling thread selects, every thread plays the leaf
+// out once, the summed rewards are backed up as `threads` visits.
+std::size_t MctsBot::search_leaf(Tree& t, std::uint64_t seed, std::size_t budget,
+                                 std::size_t threads) const {
+    std::vector<Rewards> results(threads);
+    GameState            leaf;
+    bool                 stop = false;
+    std::barrier         sync(static_cast<std::ptrdiff_t>(threads));
+
+    std::vector<std::jthread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t w = 1; w < threads; ++w) {
+        pool.emplace_back([&, w] {
+            Rng rng = Rng::stream(seed, _calls, w);   // per (seed, call, thread)
+            for (;;) {
+                sync.arrive_and_wait();          // leaf published
+                if (stop) return;
+                results[w] = rollout(leaf, rng);
+                sync.arrive_and_wait();          // result ready
+            }
+        });
+    }
+
+    Rng rng = Rng::stream(seed, _calls, 0);
+    std::vector<std::uint32_t> path;
+    path.reserve(MAX_DEPTH + 1);
+    std::size_t done = 0;
+    while (done < budget && !out_of_time()) {
+        leaf = t.nodes[select(t, path)].state;
+        sync.arrive_and_wait();
+        results[0] = rollout(leaf, rng);
+        sync.arrive_and_wait();
+
+        Rewards sum{};
+        for (const Rewards& r : results) {
+            for (std::size_t s = 0; s < sum.size(); ++s) sum[s] += r[s];
+        }
+        backprop(t, path, sum, static_cast<std::uint32_t>(threads));
+        done += threads;
+    }
+
+    stop = true;
+    sync.arrive_and_wait();
+    return done;
+}
+
+// ───────────────── Public API ─────────────────
+
+MctsBot::MctsBot(const MctsConfig& cfg) : _cfg(cfg) {
+    if (_cfg.threads == 0) _cfg.threads = std::thread::hardware_concurrency();
+    if (_cfg.threads == 0) _cfg.threads = 1;
+    if (_cfg.max_nodes < 2) _cfg.max_nodes = 2;
+}
+
+Move MctsBot::choose(const coup::Game& game) {
+    return choose(GameState::from(game));
+}
+
+Move MctsBot::choose(const GameState& state) {
+    const auto t0 = Clock::now();
+    _deadline = t0 + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double, std::milli>(_cfg.time_ms));
+    _last = MctsReport{};
+
+    MoveList& root = _root;
+    state.legal_moves(root);
+    std::vector<std::uint32_t>& visits = _visits;
+    visits.assign(root.size(), 0);
+    if (root.size() <= 1) {
+        _last.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        return root.empty() ? Move{ActionType::Pass, state.to_move(), coup::NO_SEAT} : root[0];
+    }
+
+    const std::size_t threads = _cfg.threads;
+    const std::size_t budget  = std::max<std::size_t>(_cfg.iterations, 1);
+    const std::size_t reserve = std::min(_cfg.max_nodes, budget + 1);
+
+    auto tally = [&](const Tree& t) {
+        const Node& r = t.nodes[0];
+        for (std::uint8_t e = 0; e < r.expanded; ++e) {
+            visits[e] += t.nodes[t.edges[r.first_edge + e].child].visits;
+        }
+        _last.nodes   += t.nodes.size();
+        _last.tt_hits += t.tt_hits;
+    };
+
+    if (threads > 1 && _cfg.parallel == Parallelism::Leaf) {
+        Tree t;
+        t.reset(state, reserve);
+        _last.iterations = search_leaf(t, _cfg.seed, budget, threads);
+        tally(t);
+    } else {
+        std::vector<Tree>        trees(threads);
+        std::vector<std::size_t> done(threads, 0);
+        auto work = [&](std::size_t k) {
+            Rng rng = Rng::stream(_cfg.seed, _calls, k);
+            trees[k].reset(state, reserve);
+            done[k] = search_root(trees[k], rng, budget / threads + (k < budget % threads));
+        };
+        {
+            std::vector<std::jthread> pool;
+            for (std::size_t k = 1; k < threads; ++k) pool.emplace_back(work, k);
+            work(0);
+        }
+        for (std::size_t k = 0; k < threads; ++k) {
+            _last.iterations += done[k];
+            tally(trees[k]);
+        }
+    }
+    ++_calls;
+
+    // most visited root move (robust child); ties keep generation order
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < root.size(); ++i) {
+        if (visits[i] > visits[best]) best = i;
+    }
+    _last.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    return root[best];
+}
+
+} // namespace coup_sim
@@ -0,0 +1,202 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Perft.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Position.hpp"
+#include "exceptions.hpp"
+#include "sim/Simulator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace coup_sim {
+
+using coup::ActionResult;
+using coup::ActionType;
+using coup::Game;
+using coup::GameState;
+using coup::Move;
+using coup::MoveList;
+using coup::NO_SEAT;
+
+namespace {
+
+// Adds the positions below `s` (which sits on `ply`) into counts[ply + 1 ..].
+void walk(GameState& s, unsigned ply, unsigned depth, std::uint64_t* counts) {
+    MoveList ml;
+    s.legal_moves(ml);
+    if (ply + 1 == depth) {
+        counts[depth] += ml.size();
+        return;
+    }
+    for (const Move& m : ml) {
+        ++counts[ply + 1];
+        const auto u = s.apply(m);
+        walk(s, ply + 1, depth, counts);
+        s.undo(m, u);
+    }
+}
+
+// A Game seated as `root`; the players are destroyed before their game.
+struct Table {
+    Game                                       game;
+    std::vector<std::unique_ptr<coup::Player>> owned;
+
+    explicit Table(const GameState& root) {
+        for (std::size_t i = 0; i < root.seats; ++i) {
+            owned.push_back(make_player(static_cast<std::size_t>(root.role[i]), game, "P" + std::to_string(i)));
+        }
+        for (std::size_t i = 0; i < root.seats; ++i) {
+            if (!root.is_alive(i)) game.eliminate(owned[i].get());
+        }
+        while (root.is_alive(root.turn) && game.current_player() != owned[root.turn].get()) game.next_turn();
+        // coins after the turn moved, so no Merchant bonus is paid on the way
+        for (std::size_t i = 0; i < root.seats; ++i) owned[i]->gain(root.coins[i]);
+        game.bank() = root.bank;
+        for (std::size_t i = 0; i < root.seats; ++i) {
+            coup::Player* p = owned[i].get();
+            const std::uint8_t b = static_cast<std::uint8_t>(1u << i);
+            if (root.arrest_blocked & b) game.block_arrest(p);
+            if (root.sanctioned & b)     game.block_sanction(p);
+            if (root.tax_blocked & b)    game.block_tax(p);
+            if (root.bribe_blocked & b)  game.block_bribe(p);
+        }
+    }
+};
+
+std::string move_text(const Move& m) {
+    std::string out = coup::action_name(m.type);
+    out += ' ' + std::to_string(m.actor);
+    if (m.target != NO_SEAT) out += "->" + std::to_string(m.target);
+    return out;
+}
+
+// What differs between the Game and the GameState of one node; empty if nothing.
+std::string compare(const Game& g, const GameState& s) {
+    if (s.is_terminal()) {
+        if (g.playerObjects().size() != 1) return "the game ended in GameState only";
+    } else {
+        if (g.in_reaction() != s.in_reaction()) return "a reaction window is open in one engine only";
+        MoveList gm, sm;
+        g.legal_moves(gm);
+        s.legal_moves(sm);
+        if (gm.empty()) gm.push_back({ActionType::Pass, s.turn, NO_SEAT});   // forfeit, as GameState has it
+        if (!std::equal(gm.begin(), gm.end(), sm.begin(), sm.end())) {
+            return "legal moves differ (" + std::to_string(gm.size()) + " in Game, "
+                 + std::to_string(sm.size()) + " in GameState)";
+        }
+    }
+    // GameState::from() reads no window: compare whole states between windows
+    if (!s.in_reaction() && !(GameState::from(g) == s)) {
+        return "Game is at \"" + coup::to_position(GameState::from(g)) + "\", GameState at \""
+             + coup::to_position(s) + "\"";
+    }
+    return {};
+}
+
+void check(const GameState& root, GameState& s, unsigned depth, PerftCheck& out) {
+    Table t(root);
+    for (const Move& m : out.line) {
+        if (m.type == ActionType::Pass && !t.game.in_reaction()) {
+            t.game.next_turn();                        // forfeit: nothing was legal
+        } else if (t.game.play(m) != ActionResult::Ok) {
+            out.what = "Game refused " + move_text(m);
+            return;
+        }
+    }
+    ++out.nodes;
+    out.what = compare(t.game, s);
+    if (!out.ok() || out.line.size() == depth || s.is_terminal()) return;
+
+    MoveList ml;
+    s.legal_moves(ml);
+    for (const Move& m : ml) {
+        out.line.push_back(m);
+        const auto u = s.apply(m);
+        check(root, s, depth, out);
+        if (!out.ok()) return;                         // keep the line to the mismatch
+        s.undo(m, u);
+        out.line.pop_back();
+    }
+}
+
+} // namespace
+
+PerftResult perft(const GameState& root, unsigned depth, std::size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    PerftResult r;
+    r.per_ply.assign(depth + 1, 0);
+    r.per_ply[0] = 1;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    MoveList moves;
+    root.legal_moves(moves);
+    if (depth > 0) {
+        // one row of counts per root move, summed in order afterwards
+        std::vector<std::vector<std::uint64_t>> sub(moves.size(),
+                                                    std::vector<std::uint64_t>(depth + 1, 0));
+        std::atomic<std::size_t> next{0};
+        auto work = [&] {
+            for (std::size_t i; (i = next.fetch_add(1)) < moves.size();) {
+                GameState s = root;
+                s.apply(moves[i]);
+                sub[i][1] = 1;
+                if (depth > 1) walk(s, 1, depth, sub[i].data());
+            }
+        };
+        r.threads = std::min(threads, std::max<std::size_t>(moves.size(), 1));
+        {
+            std::vector<std::jthread> pool;
+            for (std::size_t k = 1; k < r.threads; ++k) pool.emplace_back(work);
+            work();
+        }
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            for (unsigned k = 1; k <= depth; ++k) r.per_ply[k] += sub[i][k];
+            r.divide.emplace_back(moves[i], sub[i][depth]);
+        }
+    }
+
+    for (std::uint64_t n : r.per_ply) r.nodes += n;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return r;
+}
+
+PerftCheck perft_check(const GameState& root, unsigned depth) {
+    if (root.in_reaction() || root.extra_action) {
+        COUP_THROW("perft_check needs a root without an open window or extra action");
+    }
+    if (GameState::from(Table(root).game) != root) {
+        COUP_THROW("perft_check cannot seat this root in a Game (arrest history?)");
+    }
+    PerftCheck out;
+    GameState  s = root;
+    check(root, s, depth, out);
+    return out;
+}
+
+void print_perft(const PerftResult& r, bool divide) {
+    if (divide) {
+        for (const auto& [m, n] : r.divide) {
+            std::printf("  %-12s %u", coup::action_name(m.type), m.actor);
+            if (m.target != coup::NO_SEAT) std::printf("->%u", m.target);
+            std::printf("  %llu\n", static_cast<unsigned long long>(n));
+        }
+        std::printf("\n");
+    }
+    std::printf("%6s %16s\n", "ply", "positions");
+    for (std::size_t k = 0; k < r.per_ply.size(); ++k) {
+        std::printf("%6zu %16llu\n", k, static_cast<unsigned long long>(r.per_ply[k]));
+    }
+    const double secs = r.seconds > 0.0 ? r.seconds : 1e-9;
+    std::printf("nodes        : %llu\n", static_cast<unsigned long long>(r.nodes));
+    std::printf("time         : %.3f s (%zu threads)\n", r.seconds, r.threads);
+    std::printf("nodes/sec    : %.0f\n", r.nodes / secs);
+}
+
+} // namespace coup_sim
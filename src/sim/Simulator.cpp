@@ -0,0 +1,330 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Simulator.hpp"
+
+#include "Game.hpp"
+#include "GameState.hpp"
+#include "Player.hpp"
+#include "exceptions.hpp"
+#include "roles/Governor.hpp"
+#include "roles/Spy.hpp"
+#include "roles/Baron.hpp"
+#include "roles/General.hpp"
+#include "roles/Judge.hpp"
+#include "roles/Merchant.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+
+namespace coup_sim {
+
+using coup::Game;
+using coup::Player;
+using coup::ActionResult;
+using coup::ActionType;
+using coup::GameState;
+using coup::Move;
+using coup::Governor;
+using coup::Spy;
+using coup::Baron;
+using coup::Judge;
+using coup::General;
+using coup::Merchant;
+
+namespace {
+
+// Greedy preference: coup the richest opponent, otherwise grow coins fastest.
+int greedy_score(const Game& game, const Move& m) {
+    const int targetCoins = m.target != coup::NO_SEAT ? game.at_seat(m.target)->coins() : 0;
+    switch (m.type) {
+        case ActionType::Coup:        return 1000 + targetCoins;
+        case ActionType::Invest:      return 900;
+        case ActionType::Tax:         return 800;
+        case ActionType::Gather:      return 700;
+        case ActionType::Arrest:      return 600 + targetCoins;
+        case ActionType::Sanction:    return 500 + targetCoins;
+        case ActionType::TaxCancel:   return 400 + targetCoins;
+        case ActionType::BribeCancel: return 300 + targetCoins;
+        case ActionType::Bribe:       return 200;
+        default:                      return 0;   // free blocks never chosen first
+    }
+}
+
+} // namespace
+
+// ───────────────── Stats ─────────────────
+
+void SimStats::merge(const SimStats& other) noexcept {
+    games   += other.games;
+    draws   += other.draws;
+    turns   += other.turns;
+    actions += other.actions;
+    illegal += other.illegal;
+    decisions += other.decisions;
+    think     += other.think;
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) {
+        per_role[r].seats += other.per_role[r].seats;
+        per_role[r].wins  += other.per_role[r].wins;
+    }
+}
+
+std::unique_ptr<Player> make_player(std::size_t role, Game& game, const std::string& name) {
+    switch (role) {
+        case 0:  return std::make_unique<Governor>(game, name);
+        case 1:  return std::make_unique<Spy>(game, name);
+        case 2:  return std::make_unique<Baron>(game, name);
+        case 3:  return std::make_unique<General>(game, name);
+        case 4:  return std::make_unique<Judge>(game, name);
+        default: return std::make_unique<Merchant>(game, name);
+    }
+}
+
+// ───────────────── Policies ─────────────────
+
+Move random_move(const Game& game, const coup::MoveList& moves, coup::Rng& rng) {
+    std::size_t coups = 0;
+    for (const Move& m : moves) coups += m.type == ActionType::Coup;
+    const bool mustCoup = game.at_seat(moves[0].actor)->coins() >= game.rules().coup_limit && coups > 0;
+    std::uint64_t k = rng.below(mustCoup ? coups : moves.size());
+    for (const Move& m : moves) {
+        if (mustCoup && m.type != ActionType::Coup) continue;
+        if (k-- == 0) return m;
+    }
+    return moves[0];
+}
+
+Move greedy_move(const Game& game, const coup::MoveList& moves) {
+    Move pick = moves[0];
+    for (const Move& m : moves) {
+        if (greedy_score(game, m) > greedy_score(game, pick)) pick = m;
+    }
+    return pick;
+}
+
+bool random_reacts(const Move& reaction, coup::Rng& rng) {
+    return rng.below(reaction.type == ActionType::BlockCoup ? 2 : 4) == 0;
+}
+
+bool greedy_reacts(const Move& reaction) noexcept {
+    return reaction.type == ActionType::BlockCoup && reaction.target == reaction.actor;
+}
+
+void deal(Game& game, const SimConfig& cfg, coup::Rng& table, SimStats& stats) {
+    // uniform over the enabled roles (all six: r = the draw itself)
+    const unsigned enabled = game.rules().roles;
+    const auto     choices = static_cast<std::uint64_t>(std::popcount(enabled));
+    for (std::size_t i = 0; i < cfg.players; ++i) {
+        std::size_t r = 0;
+        for (std::uint64_t k = table.below(choices); ; ++r) {
+            if ((enabled >> r & 1u) && k-- == 0) break;
+        }
+        // stored in place by the game: no per-player allocation
+        game.emplace_player(static_cast<coup::RoleId>(r), "P" + std::to_string(i));
+        ++stats.per_role[r].seats;
+    }
+}
+
+void tally(const Game& game, std::size_t turns, SimStats& stats) {
+    ++stats.games;
+    stats.turns += turns;
+    if (game.alive_count() != 1) {
+        ++stats.draws;
+        return;
+    }
+    ++stats.per_role[static_cast<std::size_t>(game.playerObjects().front()->role_id())].wins;
+}
+
+// ───────────────── Simulator ─────────────────
+
+Simulator::Simulator(const SimConfig& cfg) : _cfg(cfg), _bot(cfg.mcts), _ismcts(cfg.ismcts) {
+    if (_cfg.players < 2 || _cfg.players > 6) {
+        COUP_THROW("Simulator needs between 2 and 6 players");
+    }
+    _game.set_rules(_cfg.rules);
+    if (_cfg.players > _cfg.rules.max_players) {
+        COUP_THROW("More players than the rules allow");
+    }
+    // GameState (and so MctsBot and the agents) models the standard rules only
+    if (_cfg.policy == PolicyKind::Mcts && _cfg.rules != coup::RuleSet{}) {
+        COUP_THROW("MCTS policy needs the standard rules");
+    }
+    if (_cfg.policy == PolicyKind::Agent && _cfg.rules != coup::RuleSet{}) {
+        COUP_THROW("Agent policy needs the standard rules");
+    }
+    if (_cfg.policy == PolicyKind::Ismcts && _cfg.rules != coup::RuleSet{}) {
+        COUP_THROW("ISMCTS policy needs the standard rules");
+    }
+}
+
+SimStats Simulator::run() {
+    SimStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < _cfg.games; ++i) {
+        play_game(i, stats);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    stats.seconds = std::chrono::duration<double>(t1 - t0).count();
+    return stats;
+}
+
+void Simulator::play_game(std::uint64_t game, SimStats& stats) {
+    play(game, stats, false);   // nobody reads the display log here
+}
+
+std::vector<std::string> Simulator::replay(std::uint64_t game) {
+    SimStats scratch;
+    play(game, scratch, true);
+    return _game.getActionLog();
+}
+
+void Simulator::play(std::uint64_t id, SimStats& stats, bool log) {
+    for (std::size_t s = 0; s < coup::Game::MAX_PLAYERS; ++s) {
+        _rng[s] = coup::Rng::stream(_cfg.seed, id, s);
+    }
+    coup::Rng& table = _rng.back();
+    table = coup::Rng::stream(_cfg.seed, id, coup::TABLE_STREAM);
+    _bot.reseed(_cfg.mcts.seed ^ coup::stream_key(_cfg.seed, id, coup::SEARCH_STREAM));
+    _ismcts.reseed(_cfg.ismcts.seed ^ coup::stream_key(_cfg.seed, id, coup::SEARCH_STREAM));
+
+    Game& game = _game;
+    game.reset();
+    // ISMCTS seats read the coins they cannot see off the log
+    game.set_logging(log || _cfg.policy == PolicyKind::Ismcts);
+    deal(game, _cfg, table, stats);
+    _beliefs.clear();
+    if (_cfg.policy == PolicyKind::Ismcts && _cfg.ismcts.memory == 0) {
+        for (std::size_t s = 0; s < game.seat_count(); ++s) _beliefs.emplace_back(game, s);
+    }
+
+    std::size_t turns = 0;
+    while (game.playerObjects().size() > 1 && turns < _cfg.max_turns) {
+        Player* cp = game.current_player();
+        take_turn(game, *cp, stats);
+        if (game.current_player() != cp) ++turns;
+    }
+    tally(game, turns, stats);
+}
+
+void Simulator::take_turn(Game& game, Player& cp, SimStats& stats) {
+    const bool greedy = _cfg.policy == PolicyKind::Greedy;
+    const bool search = _cfg.policy == PolicyKind::Mcts || _cfg.policy == PolicyKind::Ismcts;
+    const bool agent  = _cfg.policy == PolicyKind::Agent;
+
+    coup::MoveList moves;
+    game.legal_moves(moves);
+    if (moves.empty()) {
+        // Nothing is legal (e.g. sanctioned and broke): forfeit the turn
+        game.next_turn();
+        return;
+    }
+
+    const GameState before = search || agent ? GameState::from(game) : GameState{};
+    Move pick = moves[0];
+    if (search) {
+        pick = think(before, stats);
+    } else if (agent) {
+        pick = ask_agent(before, _rng[cp.seat()]);
+    } else if (greedy) {
+        pick = greedy_move(game, moves);
+    } else {
+        pick = random_move(game, moves, _rng[cp.seat()]);
+    }
+
+    if (game.play(pick) != ActionResult::Ok) {
+        ++stats.illegal;   // generator and rules disagree; should not happen
+        game.next_turn();
+        return;
+    }
+    ++stats.actions;
+
+    answer_reactions(game, before, pick, stats);
+}
+
+Move Simulator::ask_agent(const GameState& state, coup::Rng& rng) const {
+    coup::MoveList moves;
+    state.legal_moves(moves);
+    return with_agent(_cfg.agent, [&](auto a) { return a.pick(state, moves, rng); });
+}
+
+Move Simulator::think(const GameState& state, SimStats& stats) {
+    Move m;
+    if (_cfg.policy == PolicyKind::Ismcts) {
+        if (_beliefs.empty()) {
+            m = _ismcts.choose(state, coin_bounds(_game, state.to_move(), _cfg.ismcts.memory));
+        } else {
+            CoinTracker& seen = _beliefs[state.to_move()];
+            seen.update();   // just what was logged since this seat last thought
+            m = _ismcts.choose(state, seen.beliefs());
+        }
+        stats.think += _ismcts.last().seconds;
+    } else {
+        m = _bot.choose(state);
+        stats.think += _bot.last().seconds;
+    }
+    ++stats.decisions;
+    return m;
+}
+
+// Resolve the window the move opened inline, lowest responder first. Random
+// responders react with a fixed chance from their own stream, greedy ones
+// only to save themselves, and the searches and the agents answer on the
+// state model, which opens the same window for the same seats.
+void Simulator::answer_reactions(Game& game, GameState state, const Move& played, SimStats& stats) {
+    const bool search = _cfg.policy == PolicyKind::Mcts || _cfg.policy == PolicyKind::Ismcts;
+    const bool agent  = _cfg.policy == PolicyKind::Agent;
+    const bool mirror = search || agent;
+    if (mirror) state.apply(played);
+
+    coup::MoveList answers;
+    while (game.in_reaction()) {
+        game.reaction_moves(answers);             // { reaction, Pass }
+        const std::uint8_t r = game.responder();
+        const Move         react = answers[0];
+        Move pick = answers[1];
+        if (mirror) {
+            if (state.in_reaction() && state.to_move() == r) {
+                pick = search ? think(state, stats) : ask_agent(state, _rng[r]);
+            }
+        } else if (_cfg.policy == PolicyKind::Greedy ? greedy_reacts(react) : random_reacts(react, _rng[r])) {
+            pick = react;
+        }
+        if (mirror && state.in_reaction()) state.apply(pick);
+
+        if (game.play(pick) == ActionResult::Ok) {
+            stats.actions += pick.type != ActionType::Pass;
+        } else {
+            ++stats.illegal;
+            game.play(answers[1]);
+        }
+    }
+}
+
+// ───────────────── Reporting ─────────────────
+
+void print_report(const SimConfig& cfg, const SimStats& s) {
+    const double secs = s.seconds > 0.0 ? s.seconds : 1e-9;
+    std::printf("games        : %llu (%llu hit the %zu-turn cap)\n",
+                static_cast<unsigned long long>(s.games),
+                static_cast<unsigned long long>(s.draws), cfg.max_turns);
+    std::printf("time         : %.3f s\n", s.seconds);
+    std::printf("games/sec    : %.0f\n", s.games / secs);
+    std::printf("turns/sec    : %.0f\n", s.turns / secs);
+    std::printf("actions/sec  : %.0f (%llu rejected attempts)\n", s.actions / secs,
+                static_cast<unsigned long long>(s.illegal));
+    if (s.decisions) {
+        std::printf("mcts         : %llu decisions, %.3f ms average latency\n",
+                    static_cast<unsigned long long>(s.decisions),
+                    1000.0 * s.think / s.decisions);
+    }
+    std::printf("\n%-10s %10s %10s %9s\n", "role", "seats", "wins", "win rate");
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) {
+        const RoleStats& rs = s.per_role[r];
+        double rate = rs.seats ? 100.0 * rs.wins / rs.seats : 0.0;
+        std::printf("%-10s %10llu %10llu %8.2f%%\n", ROLE_NAMES[r],
+                    static_cast<unsigned long long>(rs.seats),
+                    static_cast<unsigned long long>(rs.wins), rate);
+    }
+}
+
+} // namespace coup_sim
@@ -0,0 +1,129 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Sweep.hpp"
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace coup_sim {
+
+// ───────────────── Grid ─────────────────
+
+SweepAxis parse_axis(std::string_view spec) {
+    const std::size_t eq = spec.find('=');
+    if (eq == std::string_view::npos || eq == 0 || eq + 1 == spec.size()) {
+        COUP_THROW("Sweep axis must look like field=v1,v2,...");
+    }
+    SweepAxis axis{std::string(spec.substr(0, eq)), {}};
+    coup::RuleSet probe;
+    if (!probe.set(axis.field, 0)) {
+        COUP_THROW("Unknown rule field: " + axis.field);
+    }
+
+    std::string_view rest = spec.substr(eq + 1);
+    while (!rest.empty()) {
+        const std::size_t comma = rest.find(',');
+        const std::string_view item = rest.substr(0, comma);
+        int v = 0;
+        auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), v);
+        if (ec != std::errc{} || end != item.data() + item.size()) {
+            COUP_THROW("Bad value in sweep axis: " + std::string(item));
+        }
+        axis.values.push_back(v);
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+    }
+    return axis;
+}
+
+void set_rule(coup::RuleSet& rules, const std::string& field, int value) {
+    if (!rules.set(field, value)) {
+        COUP_THROW("Rule field " + field + " cannot be " + std::to_string(value));
+    }
+}
+
+std::vector<RuleVariant> make_grid(const coup::RuleSet& base, const std::vector<SweepAxis>& axes) {
+    std::vector<RuleVariant> out{{"", base}};
+    for (const SweepAxis& axis : axes) {
+        std::vector<RuleVariant> next;
+        next.reserve(out.size() * axis.values.size());
+        for (const RuleVariant& v : out) {
+            for (int value : axis.values) {
+                RuleVariant w = v;
+                set_rule(w.rules, axis.field, value);
+                if (!w.label.empty()) w.label += ' ';
+                w.label += axis.field + '=' + std::to_string(value);
+                next.push_back(std::move(w));
+            }
+        }
+        out = std::move(next);
+    }
+    for (RuleVariant& v : out) {
+        if (v.label.empty()) v.label = v.rules == coup::RuleSet{} ? "standard" : "base";
+        if (const char* why = v.rules.invalid()) {
+            COUP_THROW(v.label + ": " + why);
+        }
+    }
+    return out;
+}
+
+Interval wilson(std::uint64_t k, std::uint64_t n, double z) noexcept {
+    if (n == 0) return {0.0, 1.0};
+    const double nn     = static_cast<double>(n);
+    const double p      = static_cast<double>(k) / nn;
+    const double z2     = z * z;
+    const double denom  = 1.0 + z2 / nn;
+    const double centre = (p + z2 / (2.0 * nn)) / denom;
+    const double half   = z * std::sqrt(p * (1.0 - p) / nn + z2 / (4.0 * nn * nn)) / denom;
+    return {std::max(0.0, centre - half), std::min(1.0, centre + half)};
+}
+
+// ───────────────── Sweep ─────────────────
+
+Sweep::Sweep(const SweepConfig& cfg) : _cfg(cfg) {
+    if (_cfg.variants.empty()) {
+        _cfg.variants.push_back({"standard", _cfg.run.sim.rules});
+    }
+    // fail before any game is played, not halfway through the grid
+    for (const RuleVariant& v : _cfg.variants) {
+        TournamentConfig run = _cfg.run;
+        run.sim.rules = v.rules;
+        Tournament{run};
+    }
+}
+
+std::vector<SweepResult> Sweep::run() {
+    std::vector<SweepResult> results;
+    results.reserve(_cfg.variants.size());
+    for (const RuleVariant& v : _cfg.variants) {
+        TournamentConfig run = _cfg.run;
+        run.sim.rules = v.rules;
+        results.push_back({v, Tournament(run).run()});
+    }
+    return results;
+}
+
+// ───────────────── Reporting ─────────────────
+
+void print_sweep(const SweepConfig& cfg, const std::vector<SweepResult>& results) {
+    const double level = 100.0 * std::erf(cfg.z / std::sqrt(2.0));
+    for (const SweepResult& r : results) {
+        const SimStats& s = r.stats;
+        std::printf("%s\n", r.variant.label.c_str());
+        std::printf("  %llu games, %llu draws, %.2f s\n",
+                    static_cast<unsigned long long>(s.games),
+                    static_cast<unsigned long long>(s.draws), s.seconds);
+        std::printf("  %-10s %10s %9s   %.0f%% interval\n", "role", "seats", "win rate", level);
+        for (std::size_t role = 0; role < ROLE_COUNT; ++role) {
+            const RoleStats& rs = s.per_role[role];
+            const Interval ci = wilson(rs.wins, rs.seats, cfg.z);
+            const double rate = rs.seats ? 100.0 * rs.wins / rs.seats : 0.0;
+            std::printf("  %-10s %10llu %8.2f%%   [%5.2f, %5.2f]\n", ROLE_NAMES[role],
+                        static_cast<unsigned long long>(rs.seats), rate,
+                        100.0 * ci.lo, 100.0 * ci.hi);
+        }
+    }
+}
+
+} // namespace coup_sim
@@ -0,0 +1,149 @@
+// Email: realyoavperetz@gmail.com
+#include "sim/Tournament.hpp"
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace coup_sim {
+
+namespace {
+
+constexpr std::uint64_t pack(std::uint64_t begin, std::uint64_t end) noexcept {
+    return (begin << 32) | end;
+}
+constexpr std::uint64_t range_begin(std::uint64_t bits) noexcept { return bits >> 32; }
+constexpr std::uint64_t range_end(std::uint64_t bits)   noexcept { return bits & 0xFFFFFFFFu; }
+
+} // namespace
+
+Tournament::Tournament(const TournamentConfig& cfg) : _cfg(cfg) {
+    if (_cfg.sim.games > std::numeric_limits<std::uint32_t>::max()) {
+        COUP_THROW("Tournament supports at most 2^32-1 games per run");
+    }
+    Simulator{_cfg.sim};   // reject bad settings here, not inside a worker thread
+    if (_cfg.chunk == 0) _cfg.chunk = 1;
+    _threads = _cfg.threads ? _cfg.threads : std::thread::hardware_concurrency();
+    if (_threads == 0) _threads = 1;
+    _ranges = std::make_unique<Range[]>(_threads);
+}
+
+SimStats Tournament::run() {
+    _shared.games = _shared.draws = _shared.turns = _shared.actions = _shared.illegal = 0;
+    _shared.decisions = _shared.think_ns = 0;
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) {
+        _shared.seats[r] = 0;
+        _shared.wins[r]  = 0;
+    }
+
+    // Even initial split, remainder goes to the first workers
+    const std::uint64_t total = _cfg.sim.games;
+    std::uint64_t begin = 0;
+    for (std::size_t t = 0; t < _threads; ++t) {
+        std::uint64_t share = total / _threads + (t < total % _threads ? 1 : 0);
+        _ranges[t].bits.store(pack(begin, begin + share), std::memory_order_relaxed);
+        begin += share;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    pool.reserve(_threads);
+    for (std::size_t t = 0; t < _threads; ++t) {
+        pool.emplace_back(&Tournament::worker, this, t);
+    }
+    for (auto& th : pool) th.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    SimStats out;
+    out.games   = _shared.games.load();
+    out.draws   = _shared.draws.load();
+    out.turns   = _shared.turns.load();
+    out.actions = _shared.actions.load();
+    out.illegal = _shared.illegal.load();
+    out.decisions = _shared.decisions.load();
+    out.think     = _shared.think_ns.load() * 1e-9;
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) {
+        out.per_role[r].seats = _shared.seats[r].load();
+        out.per_role[r].wins  = _shared.wins[r].load();
+    }
+    out.seconds = std::chrono::duration<double>(t1 - t0).count();
+    return out;
+}
+
+void Tournament::worker(std::size_t id) {
+    Simulator sim(_cfg.sim);
+    SimStats  local;
+    std::uint64_t begin = 0, end = 0;
+    for (;;) {
+        if (!pop(id, begin, end)) {
+            if (!steal(id)) break;
+            continue;
+        }
+        for (std::uint64_t g = begin; g < end; ++g) {
+            sim.play_game(g, local);
+        }
+    }
+    publish(local);
+}
+
+// Owner side: claim up to `chunk` games from the front of our range.
+bool Tournament::pop(std::size_t id, std::uint64_t& begin, std::uint64_t& end) {
+    auto& bits = _ranges[id].bits;
+    std::uint64_t cur = bits.load(std::memory_order_acquire);
+    for (;;) {
+        std::uint64_t b = range_begin(cur), e = range_end(cur);
+        if (b >= e) return false;
+        std::uint64_t take = std::min<std::uint64_t>(_cfg.chunk, e - b);
+        if (bits.compare_exchange_weak(cur, pack(b + take, e), std::memory_order_acq_rel)) {
+            begin = b;
+            end   = b + take;
+            return true;
+        }
+    }
+}
+
+// Thief side: split the back half off the fullest victim into our own range.
+bool Tournament::steal(std::size_t id) {
+    for (;;) {
+        std::size_t   victim = id;
+        std::uint64_t best   = 0;
+        for (std::size_t t = 0; t < _threads; ++t) {
+            if (t == id) continue;
+            std::uint64_t cur = _ranges[t].bits.load(std::memory_order_acquire);
+            std::uint64_t left = range_end(cur) - std::min(range_begin(cur), range_end(cur));
+            if (left > best) { best = left; victim = t; }
+        }
+        if (victim == id) return false;   // everyone is dry
+
+        auto& vbits = _ranges[victim].bits;
+        std::uint64_t cur = vbits.load(std::memory_order_acquire);
+        std::uint64_t b = range_begin(cur), e = range_end(cur);
+        if (b >= e) continue;
+        std::uint64_t mid = (e - b > 1) ? b + (e - b) / 2 : b;
+        if (!vbits.compare_exchange_strong(cur, pack(b, mid), std::memory_order_acq_rel)) {
+            continue;
+        }
+        _ranges[id].bits.store(pack(mid, e), std::memory_order_release);
+        return true;
+    }
+}
+
+void Tournament::publish(const SimStats& s) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    _shared.games.fetch_add(s.games, relaxed);
+    _shared.draws.fetch_add(s.draws, relaxed);
+    _shared.turns.fetch_add(s.turns, relaxed);
+    _shared.actions.fetch_add(s.actions, relaxed);
+    _shared.illegal.fetch_add(s.illegal, relaxed);
+    _shared.decisions.fetch_add(s.decisions, relaxed);
+    _shared.think_ns.fetch_add(static_cast<std::uint64_t>(s.think * 1e9), relaxed);
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) {
+        _shared.seats[r].fetch_add(s.per_role[r].seats, relaxed);
+        _shared.wins[r].fetch_add(s.per_role[r].wins, relaxed);
+    }
+}
+
+} // namespace coup_sim
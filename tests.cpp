@@ -5,19 +5,44 @@
 #include "Game.hpp"
 #include "Player.hpp"
 #include "exceptions.hpp"
+#include "GameState.hpp"
+#include "Position.hpp"
+#include "Random.hpp"
 #include "roles/Governor.hpp"
 #include "roles/Spy.hpp"
 #include "roles/Baron.hpp"
 #include "roles/General.hpp"
 #include "roles/Judge.hpp"
 #include "roles/Merchant.hpp"
+#include "sim/Agent.hpp"
+#include "sim/Async.hpp"
+#include "sim/Belief.hpp"
+#include "sim/Ismcts.hpp"
+#include "sim/Perft.hpp"
+#include "sim/Simulator.hpp"
+#include "sim/Sweep.hpp"
+#include "sim/Tournament.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <random>
 
 using namespace coup;
 
+// helper: let every responder of an open reaction window pass
+static void passWindow(Game& g) {
+    while (g.in_reaction()) {
+        g.play({ActionType::Pass, g.responder(), NO_SEAT});
+    }
+}
+
 // helper: spin the game until p’s turn, by doing always-legal gathers
 static void advanceUntil(Game& g, coup::Player& p) {
+    passWindow(g);
     while (&p != g.current_player()) {
         g.current_player()->gather();
+        passWindow(g);
     }
 }
 
@@ -229,7 +254,7 @@ TEST_CASE("5.2 General can block a coup (pays 5, attacker still pays 7)") {
     
 
     /* ---- Stage 1: fund defender enough to block & attacker enough to coup*/\
-    def.tax(); atk.gather();  // def=2, atk=1
+    def.tax(); passWindow(g); atk.gather();  // def=2, atk=1
 
     /* ---- Stage 2: fund attacker enough to coup and KEEP turn --------- */
     def.gather(); // (def=3)
@@ -279,10 +304,12 @@ TEST_CASE("6.1 Judge cancels bribe and other player still lose 4 coins") {
     // fund to 4
     for (int i = 0; i < 2; ++i) { s.tax(); advanceUntil(g, s); }
     s.bribe(); 
-    advanceUntil(g, j);
-    j.cancel_bribe(s);
+    // J answers the bribe's window before anybody moves on
+    REQUIRE(g.responder() == j.seat());
+    CHECK(g.play({ActionType::BribeCancel, j.seat(), s.seat()}) == ActionResult::Ok);
+    CHECK_FALSE(s.has_extra_action());
     // S spent 4 and does not get it back
-    CHECK(s.coins() == 2);  //6-4 =2
+    CHECK(s.coins() == 0);  //4-4 =0, no gathers on the lost extra action
 }
 /* 6.2 Spy blocks an Arrest for one turn -----------------------------*/
 TEST_CASE("6.2 Spy can block an arrest against him") {
@@ -365,4 +392,1620 @@ TEST_CASE("7.2 Action log contains gather event") {
     auto logs = g.getActionLog();
     REQUIRE(!logs.empty());
     CHECK(logs.back().rfind("S,Gather,Succeeded", 0) == 0);
-}
\ No newline at end of file
+}
+//────────────────────────────────────────────────────────
+// 8. Headless simulation
+//────────────────────────────────────────────────────────
+
+TEST_CASE("8.1 Simulator plays complete games and tallies every seat") {
+    coup_sim::SimConfig cfg;
+    cfg.games   = 50;
+    cfg.players = 4;
+    cfg.seed    = 7;
+    coup_sim::Simulator sim(cfg);
+    coup_sim::SimStats st = sim.run();
+
+    CHECK(st.games == 50);
+    std::uint64_t seats = 0, wins = 0;
+    for (const auto& r : st.per_role) { seats += r.seats; wins += r.wins; }
+    CHECK(seats == 50 * 4);
+    CHECK(wins + st.draws == 50);
+    CHECK(st.turns > 0);
+}
+
+TEST_CASE("8.2 Simulator is reproducible for a fixed seed") {
+    coup_sim::SimConfig cfg;
+    cfg.games  = 20;
+    cfg.policy = coup_sim::PolicyKind::Greedy;
+    coup_sim::SimStats a = coup_sim::Simulator(cfg).run();
+    coup_sim::SimStats b = coup_sim::Simulator(cfg).run();
+    CHECK(a.turns == b.turns);
+    for (std::size_t r = 0; r < coup_sim::ROLE_COUNT; ++r) {
+        CHECK(a.per_role[r].wins == b.per_role[r].wins);
+    }
+}
+
+TEST_CASE("8.3 Tournament totals match a single-threaded run") {
+    coup_sim::TournamentConfig cfg;
+    cfg.sim.games = 60;
+    cfg.sim.seed  = 11;
+    cfg.threads   = 3;
+    cfg.chunk     = 4;
+    coup_sim::SimStats par = coup_sim::Tournament(cfg).run();
+    coup_sim::SimStats seq = coup_sim::Simulator(cfg.sim).run();
+    CHECK(par.games == seq.games);
+    CHECK(par.turns == seq.turns);
+    for (std::size_t r = 0; r < coup_sim::ROLE_COUNT; ++r) {
+        CHECK(par.per_role[r].seats == seq.per_role[r].seats);
+        CHECK(par.per_role[r].wins  == seq.per_role[r].wins);
+    }
+}
+
+//────────────────────────────────────────────────────────
+// 9. Non-throwing action API
+//────────────────────────────────────────────────────────
+
+TEST_CASE("9.1 try_* reports the broken rule and leaves state untouched") {
+    Game g;
+    Spy   s(g, "S");
+    Baron b(g, "B");
+    CHECK(b.try_gather() == ActionResult::NotYourTurn);
+    CHECK(s.try_bribe()  == ActionResult::InsufficientCoins);
+    CHECK(s.try_arrest(s) == ActionResult::InvalidTarget);
+    CHECK(s.try_arrest(b) == ActionResult::TargetHasNoCoins);
+    CHECK(s.coins() == 0);
+    CHECK(g.current_player() == &s);
+    CHECK(g.getActionLog().empty());   // probing does not log
+
+    CHECK(s.try_gather() == ActionResult::Ok);
+    CHECK(s.coins() == 1);
+    CHECK(g.current_player() == &b);
+}
+
+TEST_CASE("9.2 Throwing API carries the result code") {
+    Game g;
+    Governor a(g, "A");
+    Judge    j(g, "J");
+    a.tax();
+    try {
+        a.sanction(j);
+        FAIL("expected CoupException");
+    } catch (const CoupException& ex) {
+        CHECK(ex.code() == ActionResult::NotYourTurn);
+    }
+    advanceUntil(g, a);
+    CHECK(a.try_sanction(j) == ActionResult::InsufficientCoins);   // 3 < 5
+    CHECK(a.coins() == 3);                                          // nothing spent
+}
+
+//────────────────────────────────────────────────────────
+// 10. Legal-move generation
+//────────────────────────────────────────────────────────
+
+static bool hasMove(const MoveList& ml, ActionType t, std::uint8_t target = NO_SEAT) {
+    for (const Move& m : ml) {
+        if (m.type == t && m.target == target) return true;
+    }
+    return false;
+}
+
+TEST_CASE("10.1 Opening moves include role extras") {
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    Judge    c(g, "C");
+    MoveList ml;
+    g.legal_moves(ml);
+    CHECK(ml.size() == 4);                        // gather, tax, block tax ×2
+    CHECK(hasMove(ml, ActionType::Gather));
+    CHECK(hasMove(ml, ActionType::Tax));
+    CHECK(hasMove(ml, ActionType::TaxCancel, 1));
+    CHECK(hasMove(ml, ActionType::TaxCancel, 2));
+    CHECK_FALSE(hasMove(ml, ActionType::Arrest, 1));   // nobody has coins yet
+
+    a.gather();                                   // now B (Spy) to move
+    g.legal_moves(ml);
+    CHECK(hasMove(ml, ActionType::Arrest, 0));
+    CHECK(hasMove(ml, ActionType::ArrestBlock, 0));
+    CHECK(hasMove(ml, ActionType::ArrestBlock, 2));
+}
+
+TEST_CASE("10.2 Mandatory coup and blocks remove moves") {
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    for (int i = 0; i < 4; ++i) { a.tax(); advanceUntil(g, a); }   // A = 12
+    std::vector<Move> moves;
+    g.legal_moves(moves);
+    bool anyIncome = false, coup = false;
+    for (const Move& m : moves) {
+        anyIncome |= m.type == ActionType::Gather || m.type == ActionType::Tax
+                  || m.type == ActionType::Bribe;
+        coup |= m.type == ActionType::Coup && m.target == 1;
+    }
+    CHECK_FALSE(anyIncome);
+    CHECK(coup);
+    CHECK(g.play(Move{ActionType::Coup, 0, 1}) == ActionResult::Ok);
+    CHECK(g.winner() == "A");
+}
+
+TEST_CASE("10.3 Every generated move is accepted by the engine") {
+    coup_sim::SimConfig cfg;
+    cfg.games   = 100;
+    cfg.players = 6;
+    coup_sim::SimStats st = coup_sim::Simulator(cfg).run();
+    CHECK(st.actions > 0);
+    CHECK(st.illegal == 0);
+}
+
+//────────────────────────────────────────────────────────
+// 11. Value-type GameState
+//────────────────────────────────────────────────────────
+
+TEST_CASE("11.1 GameState is small and round-trips apply/undo") {
+    CHECK(sizeof(GameState) <= 64);
+    GameState s;
+    s.add_seat(RoleId::Baron, 3);
+    s.add_seat(RoleId::General, 5);
+    s.add_seat(RoleId::Merchant, 0);
+    const GameState before = s;
+
+    MoveList ml;
+    s.legal_moves(ml);
+    for (const Move& m : ml) {
+        auto u = s.apply(m);
+        s.undo(m, u);
+        CHECK(s == before);
+        CHECK(s.hash() == before.hash());
+    }
+}
+
+TEST_CASE("11.2 Coup opens a General's block window") {
+    GameState s;
+    s.add_seat(RoleId::Spy, 7);
+    s.add_seat(RoleId::General, 5);
+    s.add_seat(RoleId::Judge, 0);
+    s.apply({ActionType::Coup, 0, 1});
+    REQUIRE(s.in_reaction());
+    CHECK(s.to_move() == 1);
+    MoveList ml;
+    s.legal_moves(ml);
+    REQUIRE(ml.size() == 2);
+    CHECK(ml[0] == Move{ActionType::BlockCoup, 1, 1});
+
+    GameState passed = s;
+    passed.apply({ActionType::Pass, 1, NO_SEAT});
+    CHECK_FALSE(passed.is_alive(1));
+    CHECK(passed.turn == 2);
+
+    s.apply(ml[0]);
+    CHECK(s.is_alive(1));
+    CHECK(s.coins[0] == 0);
+    CHECK(s.coins[1] == 0);
+    CHECK(s.turn == 1);
+}
+
+TEST_CASE("11.3 GameState follows Game move for move") {
+    std::mt19937 rng(3);
+    for (int round = 0; round < 30; ++round) {
+        Game g;
+        std::vector<std::unique_ptr<Player>> owned;
+        for (int i = 0; i < 5; ++i) {
+            owned.push_back(coup_sim::make_player(rng() % ROLE_COUNT, g, "P" + std::to_string(i)));
+        }
+        GameState s = GameState::from(g);
+
+        for (int ply = 0; ply < 400 && g.playerObjects().size() > 1; ++ply) {
+            // both engines open the same window; answer it the same way on each
+            while (s.in_reaction()) {
+                REQUIRE(g.responder() == s.to_move());
+                MoveList rm;
+                g.reaction_moves(rm);
+                const Move r = rm[rng() % rm.size()];
+                REQUIRE(g.play(r) == ActionResult::Ok);
+                s.apply(r);
+            }
+            CHECK_FALSE(g.in_reaction());
+            REQUIRE(s == GameState::from(g));
+
+            MoveList gm, sm;
+            g.legal_moves(gm);
+            s.legal_moves(sm);
+            if (gm.empty()) {
+                REQUIRE(sm.size() == 1);
+                g.next_turn();
+                s.apply({ActionType::Pass, s.turn, NO_SEAT});
+                continue;
+            }
+            REQUIRE(gm.size() == sm.size());
+            for (std::size_t i = 0; i < gm.size(); ++i) CHECK(gm[i] == sm[i]);
+
+            // both sides use fixed seats, so the same move plays on each
+            Move m = gm[rng() % gm.size()];
+
+            REQUIRE(g.play(m) == ActionResult::Ok);
+            s.apply(m);
+        }
+    }
+}
+
+//────────────────────────────────────────────────────────
+// 12. MCTS bot
+//────────────────────────────────────────────────────────
+
+TEST_CASE("12.1 MCTS takes a winning coup") {
+    GameState s;
+    s.add_seat(RoleId::Spy, 7);
+    s.add_seat(RoleId::Merchant, 2);
+    coup_sim::MctsConfig cfg;
+    cfg.iterations = 500;
+    coup_sim::MctsBot bot(cfg);
+    CHECK(bot.choose(s) == Move{ActionType::Coup, 0, 1});
+    CHECK(bot.last().iterations == 500);
+    CHECK(bot.last().nodes > 1);
+}
+
+TEST_CASE("12.2 MCTS General blocks the coup against itself") {
+    GameState s;
+    s.add_seat(RoleId::Spy, 7);
+    s.add_seat(RoleId::General, 5);
+    s.add_seat(RoleId::Judge, 0);
+    s.apply({ActionType::Coup, 0, 1});
+    REQUIRE(s.to_move() == 1);
+    coup_sim::MctsBot bot;
+    CHECK(bot.choose(s) == Move{ActionType::BlockCoup, 1, 1});
+}
+
+TEST_CASE("12.3 Root and leaf parallel searches return legal moves") {
+    GameState s;
+    s.add_seat(RoleId::Baron, 3);
+    s.add_seat(RoleId::Governor, 2);
+    s.add_seat(RoleId::Judge, 4);
+    MoveList legal;
+    s.legal_moves(legal);
+
+    for (auto mode : {coup_sim::Parallelism::Root, coup_sim::Parallelism::Leaf}) {
+        coup_sim::MctsConfig cfg;
+        cfg.iterations = 400;
+        cfg.threads    = 2;
+        cfg.parallel   = mode;
+        coup_sim::MctsBot bot(cfg);
+        Move m = bot.choose(s);
+        CHECK(std::find(legal.begin(), legal.end(), m) != legal.end());
+        CHECK(bot.last().iterations == 400);
+    }
+}
+
+TEST_CASE("12.4 MCTS policy plays full games through Game") {
+    coup_sim::SimConfig cfg;
+    cfg.games  = 3;
+    cfg.policy = coup_sim::PolicyKind::Mcts;
+    cfg.mcts.iterations = 50;
+    coup_sim::SimStats st = coup_sim::Simulator(cfg).run();
+    CHECK(st.games == 3);
+    CHECK(st.decisions > 0);
+    CHECK(st.illegal == 0);
+}
+
+//────────────────────────────────────────────────────────
+// 13. Seat-indexed block state
+//────────────────────────────────────────────────────────
+
+TEST_CASE("13.1 Blocks are per seat and cleared with the seat's turn") {
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    Baron    c(g, "C");
+    CHECK(a.seat() == 0);
+    CHECK(b.seat() == 1);
+    CHECK(c.seat() == 2);
+
+    g.block_sanction(&b);
+    g.block_tax(&b);
+    g.block_arrest(&c);
+    CHECK(g.is_sanctioned(&b));
+    CHECK(g.is_tax_blocked(&b));
+    CHECK_FALSE(g.is_bribe_blocked(&b));
+    CHECK(g.is_arrest_blocked(&c));
+    CHECK_FALSE(g.is_sanctioned(&a));
+
+    // a player of another game never aliases a seat here
+    Game other;
+    Spy stranger(other, "S");
+    CHECK_FALSE(g.is_sanctioned(&stranger));
+
+    g.next_turn();                 // A's turn ends: nothing on A
+    CHECK(g.is_sanctioned(&b));
+    g.next_turn();                 // B's turn ends: all of B's blocks go at once
+    CHECK_FALSE(g.is_sanctioned(&b));
+    CHECK_FALSE(g.is_tax_blocked(&b));
+    CHECK(g.is_arrest_blocked(&c));
+}
+
+TEST_CASE("13.2 A player joining mid-match takes a new seat, never a freed one") {
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    Judge    c(g, "C");
+    g.block_bribe(&b);
+    g.eliminate(&b);
+    Merchant d(g, "D");
+    CHECK(d.seat() == 3);
+    CHECK(g.at_seat(1) == &b);
+    CHECK_FALSE(g.is_bribe_blocked(&d));
+
+    // six seats per match, freed or not
+    Baron   e(g, "E");
+    General f(g, "F");
+    g.eliminate(&e);
+    CHECK_THROWS_AS(Governor(g, "G"), CoupException);
+    CHECK_THROWS_AS(g.emplace_player(RoleId::Spy, "H"), CoupException);
+    g.reset();
+    CHECK(g.emplace_player(RoleId::Spy, "H").seat() == 0);
+}
+
+TEST_CASE("13.3 A coup or bribe stays answerable after a player joins mid-match") {
+    Game g;
+    Spy&     a = g.emplace_player<Spy>("A");
+    General& b = g.emplace_player<General>("B");
+    Judge&   c = g.emplace_player<Judge>("C");
+    a.gain(7);
+    b.gain(5);
+    a.coup(c);
+    CHECK_FALSE(g.has_player(&c));
+    Merchant& d = g.emplace_player<Merchant>("D");
+    CHECK(d.seat() == 3);
+    CHECK(g.at_seat(2) == &c);             // the couped Judge is still there
+
+    b.block_coup(c);
+    CHECK(g.has_player(&c));
+    CHECK(c.seat() == 2);
+    CHECK(b.coins() == 0);
+    CHECK(g.players() == std::vector<std::string>{"A", "B", "C", "D"});
+    CHECK_THROWS(b.block_coup(c));         // nothing left to block, nothing paid
+    CHECK(b.coins() == 0);
+
+    // a bribe by a player couped since stays the couper's record, not the joiner's
+    Game h;
+    Spy&   s = h.emplace_player<Spy>("S");
+    h.emplace_player<Judge>("J");
+    h.emplace_player<Baron>("K");
+    s.gain(4);
+    s.bribe();
+    h.eliminate(&s);
+    Merchant& m = h.emplace_player<Merchant>("M");
+    CHECK(m.seat() == 3);
+    CHECK(h.last_action(&m, ActionType::Bribe) == nullptr);
+    CHECK(h.last_action(&s, ActionType::Bribe) != nullptr);
+    REQUIRE(h.reaction().action == ActionType::Bribe);
+    CHECK(h.play({ActionType::BribeCancel, 1, 0}) == ActionResult::Ok);   // S's bribe, seat 0
+    CHECK_FALSE(s.has_extra_action());
+    CHECK(m.coins() == 0);
+}
+
+//────────────────────────────────────────────────────────
+// 14. Binary action log
+//────────────────────────────────────────────────────────
+
+TEST_CASE("14.1 Log entries are compact and formatted on demand") {
+    CHECK(sizeof(LogEntry) == 8);
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    a.gather();
+    b.gather();
+    CHECK_THROWS(b.gather());          // failed attempts are logged too
+
+    const auto& e = g.log_entries();
+    REQUIRE(e.size() == 3);
+    CHECK(e[0].actor == 0);
+    CHECK(e[0].target == NO_SEAT);
+    CHECK(e[1].turn == 1);
+    CHECK_FALSE(e[2].success);
+    CHECK(g.format(e[1]) == "B,Gather,Succeeded");
+    CHECK(g.format(e[2]) == "B,Gather,Failed");
+    CHECK(g.getActionLog().size() == 3);
+}
+
+TEST_CASE("14.2 Names survive elimination and logging can be switched off") {
+    Game g;
+    Spy      a(g, "A");
+    Merchant b(g, "B");
+    a.gain(7);
+    a.coup(b);
+    CHECK(g.getActionLog().back() == "A,Coup for B,Succeeded");
+
+    Game quiet;
+    quiet.set_logging(false);
+    Governor gov(quiet, "G");
+    Baron    bar(quiet, "R");
+    gov.gather();
+    bar.tax();
+    gov.undo(bar);                     // the rules still see the tax
+    CHECK(bar.coins() == 0);
+    CHECK(quiet.log_entries().empty());
+}
+
+TEST_CASE("14.3 Tail and since views read the log without copying") {
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    CHECK(g.log_seq() == 0);
+    CHECK(g.log_tail(9).empty());
+
+    a.gather();
+    b.gather();
+    const std::uint64_t seen = g.log_seq();
+    CHECK(seen == 2);
+    a.tax();
+
+    auto tail = g.log_tail(2);
+    REQUIRE(tail.size() == 2);
+    CHECK(tail.data() == g.log_entries().data() + 1);
+    CHECK(g.format(tail.back()) == "A,Tax,Succeeded");
+    CHECK(g.log_tail(100).size() == 3);
+
+    auto fresh = g.log_since(seen);
+    REQUIRE(fresh.size() == 1);
+    CHECK(fresh[0].type == ActionType::Tax);
+    CHECK(g.log_since(g.log_seq()).empty());
+}
+
+//────────────────────────────────────────────────────────
+// 15. Deferred-blocking window
+//────────────────────────────────────────────────────────
+
+TEST_CASE("15.1 An action can be undone for one round, then expires") {
+    Game g;
+    Governor gov(g, "G");
+    Baron    bar(g, "B");
+    Spy      spy(g, "S");
+    gov.gather();
+    bar.tax();
+    REQUIRE(g.last_action(&bar, ActionType::Tax) != nullptr);
+    passWindow(g);                                            // G lets it stand for now
+    spy.gather();
+    gov.gather();
+    CHECK(g.last_action(&bar, ActionType::Tax) != nullptr);   // 3 turns old, 3 players
+    bar.gather();
+    CHECK(g.last_action(&bar, ActionType::Tax) == nullptr);   // older than a round
+    CHECK(gov.try_undo(bar) == ActionResult::NothingToUndo);
+}
+
+TEST_CASE("15.2 Failed attempts never enter the blocking window") {
+    Game g;
+    Baron    a(g, "A");
+    Governor b(g, "B");
+    a.gain(3);
+    a.sanction(b);
+    CHECK_THROWS(b.tax());
+    CHECK(g.last_action(&b, ActionType::Tax) == nullptr);
+}
+
+TEST_CASE("15.3 The window stays bounded over very long games") {
+    Game g;
+    Governor gov(g, "G");
+    Merchant m(g, "M");
+    for (int i = 0; i < 100000; ++i) g.next_turn();
+    CHECK(g.turn_count() == 100000);
+    REQUIRE(g.current_player() == &gov);
+    gov.gather();
+    m.tax();
+    CHECK(gov.try_undo(m) == ActionResult::Ok);
+    CHECK(m.coins() == 0);
+}
+
+//────────────────────────────────────────────────────────
+// 16. Role ids
+//────────────────────────────────────────────────────────
+
+TEST_CASE("16.1 role_id and role name stay in sync") {
+    Game g;
+    Judge    j(g, "J");
+    Merchant m(g, "M");
+    CHECK(j.role_id() == RoleId::Judge);
+    CHECK(j.role() == "Judge");
+
+    m.change_role(RoleId::General);
+    CHECK(m.role() == "General");
+    m.change_role(std::string("Spy"));
+    CHECK(m.role_id() == RoleId::Spy);
+    CHECK_THROWS_AS(m.change_role(std::string("Duke")), CoupException);
+    CHECK(m.role_id() == RoleId::Spy);
+}
+
+TEST_CASE("16.2 Rule checks follow the role id") {
+    Game g;
+    Baron a(g, "A");
+    Spy   b(g, "B");
+    Judge j(g, "J");
+    b.change_role(RoleId::Judge);      // sanctioning a "Judge" costs 5
+    j.change_role(RoleId::Spy);        // and a Judge now playing a Spy 3
+    a.gain(4);
+    CHECK(a.can_sanction(b) == ActionResult::InsufficientCoins);
+    a.gain(1);
+    CHECK(a.can_sanction(b) == ActionResult::Ok);
+    a.sanction(b);                     // charged what was checked
+    CHECK(a.coins() == 0);
+    CHECK(g.bank() == 1);
+
+    while (g.current_player() != &a) g.next_turn();
+    a.gain(3);
+    CHECK(a.can_sanction(j) == ActionResult::Ok);
+    a.sanction(j);
+    CHECK(a.coins() == 0);
+    CHECK(g.bank() == 1);
+}
+
+//────────────────────────────────────────────────────────
+// 17. Game-owned players
+//────────────────────────────────────────────────────────
+
+TEST_CASE("17.1 emplace_player stores roles in place and plays through them") {
+    Game g;
+    Baron&   b = g.emplace_player<Baron>("B");
+    Player&  m = g.emplace_player(RoleId::Merchant, "M");
+    Governor outside(g, "G");
+
+    CHECK(g.players() == std::vector<std::string>{"B", "M", "G"});
+    REQUIRE(g.owned(&b) != nullptr);
+    CHECK(std::holds_alternative<Baron>(*g.owned(&b)));
+    CHECK(std::holds_alternative<Merchant>(*g.owned(&m)));
+    CHECK(g.owned(&outside) == nullptr);
+
+    b.gain(3);
+    MoveList ml;
+    g.legal_moves(ml);
+    CHECK(std::find(ml.begin(), ml.end(), Move{ActionType::Invest, 0, NO_SEAT}) != ml.end());
+    CHECK(g.play({ActionType::Invest, 0, NO_SEAT}) == ActionResult::Ok);
+    CHECK(b.coins() == 6);
+}
+
+TEST_CASE("17.2 Role hooks of owned players still fire") {
+    Game g;
+    Spy&      s = g.emplace_player<Spy>("S");
+    Merchant& m = g.emplace_player<Merchant>("M");
+    m.gain(3);
+    s.arrest(m);                       // Merchant pays 2 to the bank instead
+    CHECK(m.coins() == 1);
+    CHECK(s.coins() == 0);
+    CHECK(g.bank() == 2);
+}
+
+//────────────────────────────────────────────────────────
+// 18. Game reuse and seat handles
+//────────────────────────────────────────────────────────
+
+TEST_CASE("18.1 reset() clears the match but keeps buffer capacity") {
+    Game g;
+    Governor& a = g.emplace_player<Governor>("A");
+    g.emplace_player<Baron>("B");
+    a.tax();
+    g.next_turn();
+    const std::size_t logCap    = g.log_entries().capacity();
+    const std::size_t playerCap = g.playerObjects().capacity();
+    const std::uint64_t seen    = g.log_seq();
+    const std::uint32_t match   = g.epoch();
+    REQUIRE(logCap > 0);
+    REQUIRE(seen == 1);
+
+    g.reset();
+    CHECK(g.playerObjects().empty());
+    CHECK(g.log_entries().empty());
+    CHECK(g.log_seq() == seen);               // sequence numbers never go back
+    CHECK(g.log_start() == seen);
+    CHECK(g.epoch() == match + 1);
+    CHECK(g.bank() == 0);
+    CHECK(g.log_entries().capacity() == logCap);
+    CHECK(g.playerObjects().capacity() == playerCap);
+
+    // the recycled game plays a fresh match from seat 0
+    Spy&   s = g.emplace_player<Spy>("S");
+    Judge& j = g.emplace_player<Judge>("J");
+    CHECK(g.turn() == "S");
+    CHECK(s.seat() == 0);
+    CHECK(j.seat() == 1);
+    s.gather();
+    CHECK(g.getActionLog() == std::vector<std::string>{"S,Gather,Succeeded"});
+    CHECK(g.log_seq() == seen + 1);
+    // a reader from the last match gets all of this one, a reader at 0 too
+    REQUIRE(g.log_since(seen).size() == 1);
+    CHECK(g.log_since(0).size() == 1);
+    CHECK(g.log_since(seen + 1).empty());
+}
+
+TEST_CASE("18.2 Seat handles survive turn changes and go stale on reset") {
+    Game g;
+    Governor& a = g.emplace_player<Governor>("A");
+    Baron&    b = g.emplace_player<Baron>("B");
+    Spy&      c = g.emplace_player<Spy>("C");
+    const SeatHandle hb = g.handle(b);
+    CHECK(hb.seat == 1);
+    CHECK(g.player(hb) == &b);
+
+    a.gather();
+    b.gather();
+    CHECK(g.player(hb) == &b);
+    g.eliminate(&c);
+    CHECK(g.player(g.handle(c)) == nullptr);
+    CHECK(g.player(hb) == &b);
+
+    g.reset();
+    CHECK(g.player(hb) == nullptr);
+    Judge& j = g.emplace_player<Judge>("J");
+    g.emplace_player<General>("K");
+    CHECK(g.handle(j).seat == 0);
+    CHECK(g.player(hb) == nullptr);               // seat 1 is taken again, but by a new match
+    CHECK(g.player(g.handle(j)) == &j);
+}
+
+//────────────────────────────────────────────────────────
+// 19. Fixed seats
+//────────────────────────────────────────────────────────
+
+TEST_CASE("19.1 Eliminating keeps every other seat and the turn order") {
+    Game g;
+    Governor a(g, "A");
+    Spy      b(g, "B");
+    Baron    c(g, "C");
+    Judge    d(g, "D");
+    g.eliminate(&b);
+    CHECK(g.players() == std::vector<std::string>{"A", "C", "D"});
+    CHECK(g.alive_mask() == 0b1101);
+    CHECK(g.seat_count() == 4);
+    CHECK(g.at_seat(1) == &b);                 // tombstone
+    CHECK(c.seat() == 2);
+
+    MoveList ml;
+    g.legal_moves(ml);                         // A's targets keep their seats
+    CHECK(std::find(ml.begin(), ml.end(), Move{ActionType::Sanction, 0, 3}) == ml.end());
+    CHECK(std::none_of(ml.begin(), ml.end(), [](const Move& m) { return m.target == 1; }));
+
+    a.gather();
+    CHECK(g.current_player() == &c);
+    g.eliminate(&c);                           // the mover leaves: turn passes on
+    CHECK(g.current_player() == &d);
+    d.gather();
+    CHECK(g.current_player() == &a);
+}
+
+TEST_CASE("19.2 A blocked coup restores the target in its own seat") {
+    Game     g;
+    Governor a(g, "A");
+    General  b(g, "B");
+    Spy      c(g, "C");
+    a.gain(7);
+    b.gain(5);
+    a.coup(c);                                 // C's seat is still ahead of the turn
+    CHECK(g.current_player() == &b);
+    b.block_coup(c);                           // costs B the turn
+    CHECK(g.players() == std::vector<std::string>{"A", "B", "C"});
+    CHECK(g.current_player() == &c);
+    CHECK_THROWS_AS(g.add_player(&c), CoupException);
+
+    c.gather();
+    a.gain(7);
+    a.coup(b);                                 // the turn skips B's seat...
+    CHECK(g.current_player() == &c);
+    g.cancel_coup(&b);                         // ...so B, restored, moves now
+    CHECK(g.current_player() == &b);
+    CHECK(g.players() == std::vector<std::string>{"A", "B", "C"});
+}
+
+//────────────────────────────────────────────────────────
+// 20. Runtime rules and sweeps
+//────────────────────────────────────────────────────────
+
+TEST_CASE("20.1 Costs and limits come from the game's RuleSet") {
+    RuleSet r;
+    r.coup_cost   = 5;
+    r.bribe_cost  = 2;
+    r.coup_limit  = 6;
+    r.max_players = 2;
+    Game g(r);
+    Baron   a(g, "A");
+    General b(g, "B");
+    CHECK_THROWS_AS(Spy(g, "C"), CoupException);
+
+    a.gain(5);
+    CHECK(a.can_coup(b) == ActionResult::Ok);
+    a.bribe();
+    CHECK(a.coins() == 3);
+    a.gain(3);
+    CHECK(a.can_gather() == ActionResult::MustCoup);
+    CHECK_THROWS_WITH_AS(a.gather(), "Must coup when holding 6 or more coins", CoupException);
+    CHECK(describe(ActionResult::MustCoup, RuleSet{}) == "Must coup when holding 10 or more coins");
+    a.coup(b);
+    CHECK(a.coins() == 1);
+    CHECK(g.playerObjects().size() == 1);
+
+    r.invest_gain = 9;
+    CHECK_THROWS_AS(g.set_rules(RuleSet{.max_players = 0}), CoupException);
+    g.reset();
+    g.set_rules(r);
+    Baron& c = g.emplace_player<Baron>("C");
+    c.gain(3);
+    c.invest();
+    CHECK(c.coins() == 9);
+}
+
+TEST_CASE("20.2 RuleSet fields are settable by name and validated") {
+    RuleSet r;
+    CHECK(r == RuleSet{});
+    CHECK(r.set("sanction_cost", 2));
+    CHECK(r.sanction_price(true) == 4);
+    CHECK_FALSE(r.set("no_such_rule", 1));
+    CHECK(r.invalid() == nullptr);
+    r.set("coup_cost", -1);
+    CHECK(r.invalid() != nullptr);
+    CHECK_THROWS_AS(Game{r}, CoupException);
+}
+
+TEST_CASE("20.3 Sweep grid, intervals and per-variant runs") {
+    using namespace coup_sim;
+    const SweepAxis ax = parse_axis("coup_cost=6,8");
+    CHECK(ax.values == std::vector<int>{6, 8});
+    CHECK_THROWS_AS(parse_axis("coup_cost=6,x"), CoupException);
+    CHECK_THROWS_AS(parse_axis("nope=1"), CoupException);
+
+    const auto grid = make_grid(RuleSet{}, {ax, parse_axis("bribe_cost=3,4,5")});
+    REQUIRE(grid.size() == 6);
+    CHECK(grid[1].label == "coup_cost=6 bribe_cost=4");
+    CHECK(grid[5].rules.coup_cost == 8);
+    CHECK(grid[5].rules.bribe_cost == 5);
+    CHECK(make_grid(RuleSet{}, {}).front().label == "standard");
+    // a value the field cannot hold is an error, not a grid point running the base rules
+    CHECK_THROWS_AS(make_grid(RuleSet{}, {parse_axis("max_players=-1")}), CoupException);
+    CHECK_THROWS_AS(make_grid(RuleSet{}, {parse_axis("roles=300")}), CoupException);
+
+    const Interval ci = wilson(50, 100);
+    CHECK(ci.lo == doctest::Approx(0.4038).epsilon(0.001));
+    CHECK(ci.hi == doctest::Approx(0.5962).epsilon(0.001));
+
+    SweepConfig cfg;
+    cfg.run.sim.games = 200;
+    cfg.run.threads   = 2;
+    cfg.variants      = make_grid(RuleSet{}, {ax});
+    const auto res = Sweep(cfg).run();
+    REQUIRE(res.size() == 2);
+    CHECK(res[0].stats.games == 200);
+    CHECK(res[0].stats.illegal == 0);
+    CHECK(res[1].stats.illegal == 0);
+    cfg.run.threads = 1;
+    CHECK(Sweep(cfg).run()[1].stats.per_role[0].wins == res[1].stats.per_role[0].wins);
+
+    cfg.run.sim.policy = PolicyKind::Mcts;
+    CHECK_THROWS_AS(Sweep{cfg}, CoupException);
+}
+
+//────────────────────────────────────────────────────────
+// 21. Rules policies
+//────────────────────────────────────────────────────────
+
+TEST_CASE("21.1 Constexpr and runtime rule policies play the same game") {
+    RuntimeRules::rules = RuleSet{};
+    std::mt19937 rng(5);
+    for (int round = 0; round < 20; ++round) {
+        GameState        a;
+        RuntimeGameState b;
+        for (int i = 0; i < 5; ++i) {
+            const auto r = static_cast<RoleId>(rng() % ROLE_COUNT);
+            a.add_seat(r);
+            b.add_seat(r);
+        }
+        MoveList ma, mb;
+        for (int ply = 0; ply < 300 && !a.is_terminal(); ++ply) {
+            a.legal_moves(ma);
+            b.legal_moves(mb);
+            REQUIRE(ma.size() == mb.size());
+            for (std::size_t i = 0; i < ma.size(); ++i) CHECK(ma[i] == mb[i]);
+            const Move m = ma[rng() % ma.size()];
+            a.apply(m);
+            b.apply(m);
+            REQUIRE(std::memcmp(&a, &b, sizeof a) == 0);
+        }
+    }
+}
+
+TEST_CASE("21.2 RuntimeRules and enabled roles change the rules in play") {
+    RuntimeRules::rules.coup_cost = 5;
+    RuntimeGameState s;
+    s.add_seat(RoleId::Spy, 5);
+    s.add_seat(RoleId::Judge, 0);
+    MoveList ml;
+    s.legal_moves(ml);
+    CHECK(std::find(ml.begin(), ml.end(), Move{ActionType::Coup, 0, 1}) != ml.end());
+    s.apply({ActionType::Coup, 0, 1});
+    CHECK(s.is_terminal());
+    RuntimeRules::rules = RuleSet{};
+
+    RuleSet noBaron;
+    noBaron.roles &= static_cast<std::uint8_t>(~(1u << static_cast<unsigned>(RoleId::Baron)));
+    Game g(noBaron);
+    CHECK_THROWS_AS(g.emplace_player<Baron>("B"), CoupException);
+    CHECK_NOTHROW(g.emplace_player<Judge>("J"));
+
+    coup_sim::SimConfig cfg;
+    cfg.games = 200;
+    cfg.rules = noBaron;
+    const coup_sim::SimStats st = coup_sim::Simulator(cfg).run();
+    CHECK(st.per_role[static_cast<std::size_t>(RoleId::Baron)].seats == 0);
+    CHECK(st.illegal == 0);
+}
+
+//────────────────────────────────────────────────────────
+// 22. Seeded random streams
+//────────────────────────────────────────────────────────
+
+TEST_CASE("22.1 Streams are fixed by (seed, game, seat) and differ between keys") {
+    Rng a = Rng::stream(3, 17, 2), b = Rng::stream(3, 17, 2);
+    for (int i = 0; i < 100; ++i) CHECK(a() == b());
+
+    const std::uint64_t first = Rng::stream(3, 17, 2)();
+    CHECK(Rng::stream(4, 17, 2)() != first);
+    CHECK(Rng::stream(3, 18, 2)() != first);
+    CHECK(Rng::stream(3, 17, 3)() != first);
+    CHECK(Rng::stream(3, 17, TABLE_STREAM)() != first);
+    CHECK(stream_key(0, 1, 0) != stream_key(0, 0, 1));
+
+    std::array<int, 6> hits{};
+    Rng r(9);
+    for (int i = 0; i < 6000; ++i) {
+        const std::uint64_t v = r.below(6);
+        REQUIRE(v < 6);
+        ++hits[v];
+    }
+    for (int h : hits) CHECK((h > 850 && h < 1150));
+}
+
+TEST_CASE("22.2 A game plays the same alone, in a batch and on any thread") {
+    coup_sim::SimConfig cfg;
+    cfg.games   = 40;
+    cfg.players = 5;
+    cfg.seed    = 23;
+
+    coup_sim::SimStats batch = coup_sim::Simulator(cfg).run();
+    coup_sim::SimStats split;
+    coup_sim::Simulator backwards(cfg);
+    for (std::uint64_t g = cfg.games; g-- > 0;) backwards.play_game(g, split);
+    CHECK(split.turns == batch.turns);
+    CHECK(split.actions == batch.actions);
+
+    for (std::size_t threads : {1u, 4u}) {
+        coup_sim::TournamentConfig tc;
+        tc.sim     = cfg;
+        tc.threads = threads;
+        tc.chunk   = 3;
+        coup_sim::SimStats t = coup_sim::Tournament(tc).run();
+        CHECK(t.turns == batch.turns);
+        for (std::size_t r = 0; r < coup_sim::ROLE_COUNT; ++r) {
+            CHECK(t.per_role[r].wins == batch.per_role[r].wins);
+        }
+    }
+
+    // replay(g) is game g of that batch, whatever ran before it
+    coup_sim::Simulator one(cfg), other(cfg);
+    const std::vector<std::string> log = one.replay(31);
+    other.replay(5);
+    CHECK(!log.empty());
+    CHECK(other.replay(31) == log);
+    coup_sim::SimStats single;
+    one.play_game(31, single);
+    std::uint64_t logged = 0;
+    for (const std::string& line : log) logged += line.ends_with("Succeeded");
+    CHECK(logged >= single.actions);
+}
+
+//────────────────────────────────────────────────────────
+// 23. Zobrist key
+//────────────────────────────────────────────────────────
+
+TEST_CASE("23.1 The incremental key matches a full recompute through whole games") {
+    CHECK(GameState{}.hash() == 0);
+    CHECK(GameState{}.zobrist() == 0);
+    std::mt19937 rng(8);
+    for (int round = 0; round < 20; ++round) {
+        GameState s;
+        for (int i = 0; i < 6; ++i) s.add_seat(static_cast<RoleId>(rng() % ROLE_COUNT), rng() % 4);
+        MoveList ml;
+        for (int ply = 0; ply < 300 && !s.is_terminal(); ++ply) {
+            s.legal_moves(ml);
+            const Move m = ml[rng() % ml.size()];
+            const GameState before = s;
+            const auto u = s.apply(m);
+            REQUIRE(s.key == s.zobrist());
+            if (s != before) CHECK(s.hash() != before.hash());
+            s.undo(m, u);
+            REQUIRE(s.hash() == before.hash());
+            s.apply(m);
+        }
+    }
+}
+
+TEST_CASE("23.2 Direct field writes need rehash(); transpositions share a key") {
+    GameState s;
+    s.add_seat(RoleId::Spy, 2);
+    s.add_seat(RoleId::Judge, 2);
+    const std::uint64_t k = s.hash();
+    s.coins[1] = 5;
+    CHECK(s.hash() == k);
+    s.rehash();
+    CHECK(s.hash() != k);
+    CHECK(s.hash() == s.zobrist());
+
+    // a Spy's free arrest blocks, in either order, reach one state and one key
+    GameState a, b;
+    for (GameState* x : {&a, &b}) {
+        x->add_seat(RoleId::Spy, 3);
+        x->add_seat(RoleId::Merchant, 3);
+        x->add_seat(RoleId::Baron, 3);
+    }
+    a.apply({ActionType::ArrestBlock, 0, 1});
+    a.apply({ActionType::ArrestBlock, 0, 2});
+    b.apply({ActionType::ArrestBlock, 0, 2});
+    b.apply({ActionType::ArrestBlock, 0, 1});
+    CHECK(a == b);
+    CHECK(a.hash() == b.hash());
+    CHECK(a.hash() != s.hash());
+}
+
+//────────────────────────────────────────────────────────
+// 24. Perft
+//────────────────────────────────────────────────────────
+
+TEST_CASE("24.1 Perft counts of the six-role table are pinned") {
+    // Reference numbers: a change here is a change to the rules of GameState
+    GameState s;
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) s.add_seat(static_cast<RoleId>(r), 2);
+    const coup_sim::PerftResult p = coup_sim::perft(s, 5);
+    CHECK(p.per_ply == std::vector<std::uint64_t>{1, 12, 142, 1146, 7446, 52836});
+    CHECK(p.nodes == 1 + 12 + 142 + 1146 + 7446 + 52836);
+
+    MoveList ml;
+    s.legal_moves(ml);
+    CHECK(coup_sim::perft(s, 1).leaves() == ml.size());
+    CHECK(coup_sim::perft(s, 0).nodes == 1);
+}
+
+TEST_CASE("24.2 Perft root split gives the same counts on any thread count") {
+    GameState s;
+    s.add_seat(RoleId::Baron, 3);
+    s.add_seat(RoleId::General, 5);
+    s.add_seat(RoleId::Judge, 4);
+    s.add_seat(RoleId::Governor, 7);
+    const coup_sim::PerftResult one  = coup_sim::perft(s, 5, 1);
+    const coup_sim::PerftResult many = coup_sim::perft(s, 5, 3);
+    CHECK(one.per_ply == many.per_ply);
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < one.divide.size(); ++i) {
+        CHECK(one.divide[i] == many.divide[i]);
+        sum += one.divide[i].second;
+    }
+    CHECK(sum == one.leaves());
+}
+
+TEST_CASE("24.3 Perft lines replay through Game to the same positions") {
+    // Player.cpp and the role files walk the same tree as GameState
+    GameState s;
+    for (std::size_t r = 0; r < ROLE_COUNT; ++r) s.add_seat(static_cast<RoleId>(r), 2);
+    const coup_sim::PerftCheck all = coup_sim::perft_check(s, 3);
+    CHECK(all.ok());
+    CHECK(all.nodes == 1 + 12 + 142 + 1146);
+
+    // a blocked coup with a Merchant next in line, and blocks at the root
+    GameState m;
+    m.add_seat(RoleId::Spy, 7);
+    m.add_seat(RoleId::General, 5);
+    m.add_seat(RoleId::Merchant, 3);
+    m.add_seat(RoleId::Governor, 4);
+    m.tax_blocked = 0b1000;
+    m.rehash();
+    const coup_sim::PerftCheck line = coup_sim::perft_check(m, 4);
+    CHECK_MESSAGE(line.ok(), line.what);
+    CHECK(line.nodes == coup_sim::perft(m, 4).nodes);
+
+    m.extra_action = 1;
+    m.rehash();
+    CHECK_THROWS_AS(coup_sim::perft_check(m, 2), CoupException);
+}
+
+//────────────────────────────────────────────────────────
+// 25. Position notation
+//────────────────────────────────────────────────────────
+
+TEST_CASE("25.1 Positions parse into the state they describe and print back") {
+    GameState s = parse_position("Ba9/Ju0s 0 0");
+    CHECK(s.seats == 2);
+    CHECK(s.role[0] == RoleId::Baron);
+    CHECK(s.coins[0] == 9);
+    CHECK(s.sanctioned == 0b10);
+    CHECK(s.turn == 0);
+    CHECK(s.hash() == s.zobrist());
+    CHECK(to_position(s) == "Ba9/Ju0s 0 0");
+
+    s = parse_position("Ba4a/Ju3/go0/Me6t/Sp2>3 3+ -2 Bribe@3:1");
+    CHECK_FALSE(s.is_alive(2));
+    CHECK(s.arrest_blocked == 0b1);
+    CHECK(s.tax_blocked == 0b1000);
+    CHECK(s.last_arrest[4] == 3);
+    CHECK(s.extra_action == 1);
+    CHECK(s.bank == -2);
+    CHECK(s.to_move() == 1);
+    CHECK(to_position(s) == "Ba4a/Ju3/go0/Me6t/Sp2>3 3+ -2 Bribe@3:1");
+
+    // the same state the engine reaches by playing the coup
+    GameState played;
+    played.add_seat(RoleId::Spy, 7);
+    played.add_seat(RoleId::General, 5);
+    played.add_seat(RoleId::Judge, 0);
+    played.apply({ActionType::Coup, 0, 1});
+    CHECK(played == parse_position("Sp0/Ge5/Ju0 0 0 Coup@0>1:1"));
+
+    for (const char* bad : {"", "Xx1 0 0", "Ba1/Ju1", "Ba1/Ju1 2 0", "Ba1/ju1 1 0",
+                            "Ba1/Ju1 0 0 Gather@0:1", "Ba1/Ju1>1 0 0", "Ba1/Ju1 0 0 Tax@0:",
+                            "Ba256/Ju1 0 0", "Ba1/Ju1 0 0 x"}) {
+        CHECK_THROWS_AS(parse_position(bad), CoupException);
+    }
+}
+
+TEST_CASE("25.2 Every state of random games round-trips; the suite loads") {
+    std::mt19937 rng(12);
+    for (int round = 0; round < 20; ++round) {
+        GameState s;
+        for (int i = 0; i < 5; ++i) s.add_seat(static_cast<RoleId>(rng() % ROLE_COUNT), rng() % 6);
+        MoveList ml;
+        for (int ply = 0; ply < 200 && !s.is_terminal(); ++ply) {
+            REQUIRE(parse_position(to_position(s)) == s);
+            s.legal_moves(ml);
+            s.apply(ml[rng() % ml.size()]);
+        }
+    }
+
+    const std::vector<NamedPosition> suite = load_positions("assets/positions.txt");
+    CHECK(suite.size() >= 8);
+    for (const NamedPosition& p : suite) CHECK(parse_position(to_position(p.state)) == p.state);
+
+    std::istringstream in("# comment\n\nok Ba1/Ju1 0 0\nbroken Ba1/Ju1 7 0\n");
+    CHECK_THROWS_WITH_AS(read_positions(in), doctest::Contains("Line 4"), CoupException);
+}
+
+//────────────────────────────────────────────────────────
+// 26. Reaction windows
+//────────────────────────────────────────────────────────
+
+TEST_CASE("26.1 A tax opens a window for the other Governors, answered in seat order") {
+    Game g;
+    Governor a(g, "A");
+    General  b(g, "B");
+    Governor c(g, "C");
+    Judge    d(g, "D");
+    a.gather();
+    CHECK_FALSE(g.in_reaction());
+    CHECK(g.play({ActionType::Pass, 0, NO_SEAT}) == ActionResult::NotAvailable);
+
+    b.tax();
+    CHECK(g.reaction() == Reaction{ActionType::Tax, 1, NO_SEAT, 0b0101});
+    CHECK(g.current_player() == &c);           // the tax already took effect
+    MoveList ml;
+    g.reaction_moves(ml);
+    REQUIRE(ml.size() == 2);
+    CHECK(ml[0] == Move{ActionType::TaxUndo, 0, 1});
+    CHECK(ml[1] == Move{ActionType::Pass, 0, NO_SEAT});
+    CHECK(g.play({ActionType::TaxUndo, 2, 1}) == ActionResult::NotYourTurn);
+    CHECK(g.play(ml[1]) == ActionResult::Ok);
+    CHECK(g.responder() == 2);
+    CHECK(g.play({ActionType::TaxUndo, 2, 1}) == ActionResult::Ok);
+    CHECK(b.coins() == 0);
+    CHECK_FALSE(g.in_reaction());
+    CHECK(g.getActionLog().back() == "C,UndoTax for B,Succeeded");
+
+    c.tax();                                   // A may undo...
+    CHECK(g.responder() == 0);
+    CHECK(g.current_player() == &d);
+    CHECK_THROWS_AS(d.gather(), CoupException);   // ...and nobody moves until A answers
+    g.legal_moves(ml);
+    CHECK(ml[0] == Move{ActionType::TaxUndo, 0, 2});
+    CHECK(g.play({ActionType::Gather, 3, NO_SEAT}) == ActionResult::NotYourTurn);
+    CHECK(g.play({ActionType::Pass, 0, NO_SEAT}) == ActionResult::Ok);
+    CHECK_FALSE(g.in_reaction());
+    d.gather();
+    CHECK(c.coins() == 3);
+}
+
+TEST_CASE("26.2 A cancelled bribe stays paid; a blocked coup keeps the turn order") {
+    Game g;
+    Spy     s(g, "S");
+    Judge   j(g, "J");
+    General k(g, "K");
+    s.gain(4);
+    s.bribe();
+    CHECK(g.reaction() == Reaction{ActionType::Bribe, 0, NO_SEAT, 0b010});
+    CHECK(g.play({ActionType::BribeCancel, 1, 0}) == ActionResult::Ok);
+    CHECK(s.coins() == 0);
+    CHECK_FALSE(s.has_extra_action());
+    CHECK(g.current_player() == &s);           // the turn itself goes on
+    s.gather();
+    CHECK(g.current_player() == &j);
+
+    j.gain(7);
+    k.gain(5);
+    j.coup(k);                                 // the couped General answers from out of play
+    CHECK(g.reaction() == Reaction{ActionType::Coup, 1, 2, 0b100});
+    CHECK(g.current_player() == &s);
+    CHECK(s.try_block_arrest(j) == ActionResult::NotYourTurn);   // even free actions wait for K
+    MoveList ml;
+    g.legal_moves(ml);
+    REQUIRE(ml.size() == 2);
+    CHECK(ml[0] == Move{ActionType::BlockCoup, 2, 2});
+    CHECK(g.play({ActionType::BlockCoup, 2, 2}) == ActionResult::Ok);
+    CHECK(g.players() == std::vector<std::string>{"S", "J", "K"});
+    CHECK(g.current_player() == &k);           // K's seat came before S's
+    CHECK(j.coins() == 0);
+    CHECK(k.coins() == 0);
+    CHECK(g.getActionLog().back() == "K,BlockCoup for K,Succeeded");
+    CHECK_FALSE(g.in_reaction());
+}
+
+TEST_CASE("26.3 A blocked coup pays the next Merchant once, as GameState does") {
+    Game g;
+    Spy      s(g, "S");
+    General  k(g, "K");
+    Merchant m(g, "M");
+    s.gain(7);
+    k.gain(5);
+    m.gain(3);
+    GameState st = GameState::from(g);
+
+    s.coup(k);
+    st.apply({ActionType::Coup, 0, 1});
+    CHECK(m.coins() == 3);                     // M moves next, but not before K answers
+    MoveList ml;
+    g.reaction_moves(ml);
+    REQUIRE(ml.size() == 2);
+    REQUIRE(g.play(ml[0]) == ActionResult::Ok);
+    st.apply(ml[0]);
+    CHECK(g.current_player() == &k);
+    CHECK(m.coins() == 3);
+    CHECK(st == GameState::from(g));
+
+    k.gather();
+    st.apply({ActionType::Gather, 1, NO_SEAT});
+    CHECK(m.coins() == 4);                     // paid on its real turn only
+    CHECK(st == GameState::from(g));
+}
+
+//────────────────────────────────────────────────────────
+// 27. Coroutine agents
+//────────────────────────────────────────────────────────
+
+TEST_CASE("27.1 Coroutine agents play the simulator's games on any threads and lanes") {
+    for (coup_sim::PolicyKind policy : {coup_sim::PolicyKind::Random, coup_sim::PolicyKind::Greedy}) {
+        coup_sim::AsyncConfig cfg;
+        cfg.sim.games   = 60;
+        cfg.sim.players = 5;
+        cfg.sim.seed    = 29;
+        cfg.sim.policy  = policy;
+        const coup_sim::SimStats batch = coup_sim::Simulator(cfg.sim).run();
+
+        for (auto [threads, lanes] : {std::pair{1u, 1u}, {1u, 16u}, {3u, 7u}}) {
+            cfg.threads = threads;
+            cfg.lanes   = lanes;
+            const coup_sim::SimStats a = coup_sim::run_async(cfg);
+            CHECK(a.games == batch.games);
+            CHECK(a.turns == batch.turns);
+            CHECK(a.actions == batch.actions);
+            CHECK(a.illegal == 0);
+            for (std::size_t r = 0; r < coup_sim::ROLE_COUNT; ++r) {
+                CHECK(a.per_role[r].wins == batch.per_role[r].wins);
+            }
+        }
+    }
+    coup_sim::AsyncConfig mcts;
+    mcts.sim.policy = coup_sim::PolicyKind::Mcts;
+    CHECK_THROWS_AS(coup_sim::run_async(mcts), CoupException);
+}
+
+namespace {
+
+// Hops onto the pool before every answer: the game waits without a thread
+coup_sim::AgentTask hopping_agent(coup_sim::Seat& seat, coup::Rng rng) {
+    while (const coup_sim::Decision* d = co_await seat.next()) {
+        co_await seat.scheduler()->schedule();
+        seat.play(d->reaction ? d->moves[1] : coup_sim::random_move(*d->game, d->moves, rng));
+    }
+}
+
+coup_sim::AgentTask failing_agent(coup_sim::Seat& seat) {
+    const coup_sim::Decision* d = co_await seat.next();
+    if (d && !d->reaction) seat.play({ActionType::Pass, d->seat, NO_SEAT});   // never legal on a turn
+    co_await seat.next();
+    throw CoupException("agent gave up");
+}
+
+} // namespace
+
+TEST_CASE("27.2 Agents may suspend between decisions; bad answers and throws surface") {
+    coup_sim::AsyncConfig cfg;
+    cfg.sim.games   = 50;
+    cfg.sim.players = 4;
+    cfg.threads     = 2;
+    cfg.lanes       = 8;
+    auto hopping = [&](coup_sim::Seat& seat, std::uint64_t game) {
+        return hopping_agent(seat, coup::Rng::stream(cfg.sim.seed, game, seat.index()));
+    };
+    const coup_sim::SimStats a = coup_sim::run_async(cfg, hopping);
+    cfg.threads = 1;
+    cfg.lanes   = 1;
+    const coup_sim::SimStats b = coup_sim::run_async(cfg, hopping);
+    CHECK(a.games == 50);
+    CHECK(a.illegal == 0);
+    CHECK(a.turns == b.turns);
+    CHECK(a.actions == b.actions);
+
+    cfg.sim.games = 3;
+    CHECK_THROWS_WITH_AS(coup_sim::run_async(cfg, [](coup_sim::Seat& seat, std::uint64_t) {
+                             return failing_agent(seat);
+                         }),
+                         "agent gave up", CoupException);
+}
+
+//────────────────────────────────────────────────────────
+// 28. Static agents
+//────────────────────────────────────────────────────────
+
+namespace {
+
+// The agent's pick for the side to move of `pos`
+template <class A>
+Move agent_pick(A agent, const char* pos, std::uint64_t seed = 1) {
+    const GameState s = parse_position(pos);
+    MoveList ml;
+    s.legal_moves(ml);
+    Rng rng(seed);
+    return agent.pick(s, ml, rng);
+}
+
+} // namespace
+
+TEST_CASE("28.1 Built-in agents pick what their policy says") {
+    static_assert(coup_sim::Agent<coup_sim::UniformAgent>);
+    static_assert(!coup_sim::Agent<int>);
+
+    // income: the role's best earner, a forced coup on the richest, a self-block
+    CHECK(agent_pick(coup_sim::IncomeAgent{}, "Go2/Ba4/Ju1 0 0") == Move{ActionType::Tax, 0, NO_SEAT});
+    CHECK(agent_pick(coup_sim::IncomeAgent{}, "Ba3/Go0 0 0") == Move{ActionType::Invest, 0, NO_SEAT});
+    CHECK(agent_pick(coup_sim::IncomeAgent{}, "Sp2t/Ge4/Me5 0 0") == Move{ActionType::Gather, 0, NO_SEAT});
+    CHECK(agent_pick(coup_sim::IncomeAgent{}, "Ba10/Ju3/Go8 0 0") == Move{ActionType::Coup, 0, 2});
+    CHECK(agent_pick(coup_sim::IncomeAgent{}, "Sp7/Ju3/Go8 0 0").type != ActionType::Coup);
+    CHECK(agent_pick(coup_sim::IncomeAgent{}, "Sp0/Ge5/Ju0 0 0 Coup@0>1:1") ==
+          Move{ActionType::BlockCoup, 1, 1});
+
+    // coup-first: any legal coup, on the richest; otherwise uniform
+    CHECK(agent_pick(coup_sim::CoupFirstAgent{}, "Sp7/Ge2/Ju5 0 0") == Move{ActionType::Coup, 0, 2});
+    CHECK(agent_pick(coup_sim::CoupFirstAgent{}, "Sp0/Ge5/Ju0 0 0 Coup@0>1:1") ==
+          Move{ActionType::BlockCoup, 1, 1});
+    for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+        const char* pos = "Go2/Ba4/Ju1 0 0";
+        GameState s = parse_position(pos);
+        MoveList ml;
+        s.legal_moves(ml);
+        Rng rng(seed);
+        CHECK(agent_pick(coup_sim::CoupFirstAgent{}, pos, seed) == ml[rng.below(ml.size())]);
+        CHECK(agent_pick(coup_sim::UniformAgent{}, pos, seed) == agent_pick(coup_sim::CoupFirstAgent{}, pos, seed));
+    }
+
+    coup_sim::AgentKind k{};
+    CHECK(coup_sim::agent_from_name("coupfirst", k));
+    CHECK(k == coup_sim::AgentKind::CoupFirst);
+    CHECK_FALSE(coup_sim::agent_from_name("greedy", k));
+    CHECK(k == coup_sim::AgentKind::CoupFirst);
+}
+
+TEST_CASE("28.2 Inline and type-erased agents play the same games for search and self-play") {
+    for (std::size_t kind = 0; kind < coup_sim::AGENT_COUNT; ++kind) {
+        const auto k = static_cast<coup_sim::AgentKind>(kind);
+        for (std::uint64_t seed = 1; seed <= 10; ++seed) {
+            GameState a;
+            for (std::size_t r = 0; r < ROLE_COUNT; ++r) a.add_seat(static_cast<RoleId>(r), 2);
+            GameState b = a;
+            Rng ra(seed), rb(seed);
+            const std::size_t n = coup_sim::with_agent(k, [&](auto agent) {
+                return coup_sim::playout(a, agent, ra, 400);
+            });
+            coup_sim::AnyAgent any = coup_sim::make_agent(k);
+            CHECK(coup_sim::playout(b, any, rb, 400) == n);
+            CHECK(a == b);
+            CHECK((a.is_terminal() || n == 400));
+        }
+
+        coup_sim::MctsConfig mc;
+        mc.iterations = 200;
+        mc.rollout    = k;
+        coup_sim::MctsBot bot(mc);
+        const GameState root = parse_position("Ba3/Ge5/Ju2/Go4 0 0");
+        MoveList ml;
+        root.legal_moves(ml);
+        const Move m = bot.choose(root);
+        CHECK(std::find(ml.begin(), ml.end(), m) != ml.end());
+
+        coup_sim::SimConfig cfg;
+        cfg.games   = 100;
+        cfg.players = 5;
+        cfg.policy  = coup_sim::PolicyKind::Agent;
+        cfg.agent   = k;
+        const coup_sim::SimStats st = coup_sim::Simulator(cfg).run();
+        CHECK(st.games == 100);
+        CHECK(st.illegal == 0);
+        CHECK(coup_sim::Simulator(cfg).run().turns == st.turns);
+    }
+
+    coup_sim::SimConfig odd;
+    odd.policy          = coup_sim::PolicyKind::Agent;
+    odd.rules.coup_cost = 6;
+    CHECK_THROWS_AS(coup_sim::Simulator{odd}, CoupException);
+}
+
+//────────────────────────────────────────────────────────
+// 29. Hidden coins (ISMCTS)
+//────────────────────────────────────────────────────────
+
+TEST_CASE("29.1 Log bounds hold the true coins and are exact over the whole log") {
+    Game g;
+    g.set_logging(true);
+    Governor a(g, "A");
+    Baron    b(g, "B");
+    Merchant c(g, "C");
+    a.tax();
+    b.gather();
+    c.gather();
+    a.arrest(b);
+    coup_sim::CoinBounds all = coup_sim::coin_bounds(g, 2);
+    CHECK(all[0] == coup_sim::CoinRange::exact(4));
+    CHECK(all[1] == coup_sim::CoinRange::exact(0));
+    CHECK(all[2] == coup_sim::CoinRange::exact(1));
+
+    // the last two entries only: the arrest proves B had a coin
+    coup_sim::CoinBounds two = coup_sim::coin_bounds(g, 2, 2);
+    CHECK(two[0] == coup_sim::CoinRange{1, 21});
+    CHECK(two[1] == coup_sim::CoinRange{0, 19});
+    CHECK(two[2] == coup_sim::CoinRange::exact(1));
+
+    // random logged games with reactions: truth always in range, for any memory
+    coup_sim::SimConfig cfg;
+    cfg.players = 6;
+    for (std::uint64_t id = 0; id < 30; ++id) {
+        Game game;
+        Rng table = Rng::stream(5, id, TABLE_STREAM), rng(id);
+        coup_sim::SimStats st;
+        game.set_logging(true);
+        coup_sim::deal(game, cfg, table, st);
+        MoveList ml;
+        for (int ply = 0; ply < 400 && game.alive_count() > 1; ++ply) {
+            if (game.in_reaction()) {
+                game.reaction_moves(ml);
+            } else {
+                game.legal_moves(ml);
+                if (ml.empty()) { game.next_turn(); continue; }
+            }
+            const std::size_t me = ply % game.seat_count();
+            for (std::size_t memory : {0u, 1u, 7u}) {
+                const coup_sim::CoinBounds cb = coup_sim::coin_bounds(game, me, memory);
+                for (std::size_t s = 0; s < game.seat_count(); ++s) {
+                    const Player* p = game.at_seat(s);
+                    if (!p) continue;
+                    REQUIRE(cb[s].contains(p->coins()));
+                    if (memory == 0 || s == me) CHECK(cb[s].known());
+                }
+            }
+            REQUIRE(game.play(ml[rng.below(ml.size())]) == ActionResult::Ok);
+        }
+    }
+}
+
+TEST_CASE("29.2 ISMCTS draws worlds inside the bounds and picks the same move on any threads") {
+    const GameState s = parse_position("Ba3/Ge5/Ju2/Go4 0 0");
+    coup_sim::CoinBounds cb{};
+    cb[0] = coup_sim::CoinRange::exact(3);
+    cb[1] = {2, 8};
+    cb[2] = {0, 4};
+    cb[3] = coup_sim::CoinRange::exact(4);
+    Rng rng(3);
+    bool varied = false;
+    for (int i = 0; i < 50; ++i) {
+        const GameState w = coup_sim::determinize(s, cb, 0, rng);
+        CHECK(w.coins[0] == 3);
+        for (std::size_t t = 1; t < 4; ++t) CHECK(cb[t].contains(w.coins[t]));
+        CHECK(w.hash() == w.zobrist());
+        varied |= w.coins[1] != s.coins[1];
+    }
+    CHECK(varied);
+
+    coup_sim::IsmctsConfig ic;
+    ic.worlds            = 6;
+    ic.search.iterations = 150;
+    MoveList ml;
+    s.legal_moves(ml);
+    coup_sim::IsmctsBot one(ic);
+    ic.threads = 3;
+    coup_sim::IsmctsBot three(ic);
+    for (int call = 0; call < 3; ++call) {
+        const Move m = one.choose(s, cb);
+        CHECK(three.choose(s, cb) == m);
+        CHECK(std::find(ml.begin(), ml.end(), m) != ml.end());
+        CHECK(one.last().worlds == 6);
+        CHECK(one.last().iterations == three.last().iterations);
+    }
+
+    ic.time_ms = 5;
+    coup_sim::IsmctsBot timed(ic);
+    const Move m = timed.choose(s, cb);
+    CHECK(std::find(ml.begin(), ml.end(), m) != ml.end());
+    CHECK(timed.last().worlds >= 1);
+
+    // self-play through the real game and its log
+    coup_sim::SimConfig cfg;
+    cfg.games                    = 2;
+    cfg.players                  = 4;
+    cfg.policy                   = coup_sim::PolicyKind::Ismcts;
+    cfg.ismcts.worlds            = 2;
+    cfg.ismcts.memory            = 12;
+    cfg.ismcts.search.iterations = 20;
+    const coup_sim::SimStats st = coup_sim::Simulator(cfg).run();
+    CHECK(st.games == 2);
+    CHECK(st.illegal == 0);
+    CHECK(st.decisions > 0);
+    CHECK(coup_sim::Simulator(cfg).run().turns == st.turns);
+
+    Game g;
+    Spy     a(g, "A");
+    General b(g, "B");
+    a.gain(7);
+    b.gain(5);
+    a.coup(b);
+    REQUIRE(g.in_reaction());
+    CHECK_THROWS_AS(coup_sim::IsmctsBot{}.choose(g), CoupException);
+}
+
+//────────────────────────────────────────────────────────
+// 30. Coin beliefs
+//────────────────────────────────────────────────────────
+
+TEST_CASE("30.1 Coin distributions narrow like ranges; trackers read only new entries") {
+    coup_sim::CoinDist d = coup_sim::CoinDist::uniform({2, 5});
+    CHECK(d.mean() == doctest::Approx(3.5));
+    d.at_least(4);
+    CHECK(d.range() == coup_sim::CoinRange{4, 5});
+    CHECK(d[4] == doctest::Approx(0.5));
+    d.shift(-4);
+    CHECK(d.range() == coup_sim::CoinRange{0, 1});
+    d.below(1);
+    CHECK(d.range() == coup_sim::CoinRange::exact(0));
+    d.at_least(3);                             // nothing survives: the nearest count
+    CHECK(d.range() == coup_sim::CoinRange::exact(3));
+
+    const coup_sim::CoinDist u = coup_sim::CoinDist::uniform({2, 5});
+    std::array<int, 8> hits{};
+    Rng rng(4);
+    for (int i = 0; i < 4000; ++i) ++hits[static_cast<std::size_t>(u.sample(rng))];
+    CHECK(hits[1] + hits[6] == 0);
+    for (int c = 2; c <= 5; ++c) CHECK((hits[c] > 850 && hits[c] < 1150));
+
+    Game g;
+    g.set_logging(true);
+    Governor a(g, "A");
+    Baron    b(g, "B");
+    Spy      c(g, "C");
+    Merchant e(g, "E");
+    coup_sim::CoinTracker full(g, 2);
+    a.tax();
+    b.gather();
+    c.gather();
+    e.gather();
+    coup_sim::CoinTracker late(g, 2, g.log_seq());
+    a.arrest(b);
+    b.gather();
+    CHECK(full.update() == 6);
+    CHECK(full.update() == 0);
+    CHECK(late.update() == 2);
+    CHECK(full.bounds() == coup_sim::coin_bounds(g, 2));
+    for (std::size_t s = 0; s < 4; ++s) CHECK(full.dist(s)[g.at_seat(s)->coins()] == 1.0f);
+    CHECK(late.bounds() == coup_sim::coin_bounds(g, 2, 2));
+    CHECK(late.dist(1).range() == coup_sim::CoinRange{1, 10});
+    CHECK(late.dist(3).range() == coup_sim::CoinRange{0, 20});
+    CHECK(late.dist(2).range() == coup_sim::CoinRange::exact(1));
+
+    // a Spy's reading is exact until later entries move it
+    late.inspect(c, 3);
+    CHECK(late.dist(3).range() == coup_sim::CoinRange::exact(1));
+    c.gather();
+    e.gather();
+    late.update();
+    CHECK(late.dist(3).range() == coup_sim::CoinRange::exact(2));
+    CHECK(late.dist(2).range() == coup_sim::CoinRange::exact(2));
+    CHECK_THROWS_AS(late.inspect(c, 5), CoupException);
+
+    // one match per tracker; after reset() a fresh one starts exact again
+    Game h;
+    h.set_logging(true);
+    h.emplace_player<Governor>("A").tax();
+    h.reset();
+    h.emplace_player<Governor>("A");
+    Baron& hb = h.emplace_player<Baron>("B");
+    coup_sim::CoinTracker fresh(h, 1);
+    h.at_seat(0)->gather();
+    coup_sim::CoinTracker stale = fresh;
+    CHECK(fresh.update() == 1);
+    CHECK(fresh.dist(0).range() == coup_sim::CoinRange::exact(1));
+    CHECK(fresh.dist(1).range() == coup_sim::CoinRange::exact(hb.coins()));
+    h.reset();
+    CHECK_THROWS_AS(stale.update(), CoupException);
+}
+
+TEST_CASE("30.2 Trackers agree with a log rescan and feed ISMCTS") {
+    coup_sim::SimConfig cfg;
+    cfg.players = 5;
+    for (std::uint64_t id = 0; id < 20; ++id) {
+        Game game;
+        Rng table = Rng::stream(8, id, TABLE_STREAM), rng(id);
+        coup_sim::SimStats st;
+        game.set_logging(true);
+        coup_sim::deal(game, cfg, table, st);
+        std::vector<coup_sim::CoinTracker> full, late;
+        for (std::size_t s = 0; s < game.seat_count(); ++s) full.emplace_back(game, s);
+        MoveList ml;
+        for (int ply = 0; ply < 300 && game.alive_count() > 1; ++ply) {
+            if (ply == 40) {
+                for (std::size_t s = 0; s < game.seat_count(); ++s) late.emplace_back(game, s, game.log_seq());
+            }
+            if (game.in_reaction()) {
+                game.reaction_moves(ml);
+            } else {
+                game.legal_moves(ml);
+                if (ml.empty()) { game.next_turn(); continue; }
+            }
+            const std::size_t me = ply % game.seat_count();
+            full[me].update();
+            REQUIRE(full[me].bounds() == coup_sim::coin_bounds(game, me));
+            if (!late.empty()) late[me].update();
+            for (std::size_t s = 0; s < game.seat_count(); ++s) {
+                const int coins = game.at_seat(s)->coins();
+                CHECK(full[me].dist(s)[static_cast<std::size_t>(coins)] == 1.0f);
+                if (!late.empty()) CHECK(late[me].dist(s)[static_cast<std::size_t>(coins)] > 0.0f);
+            }
+            REQUIRE(game.play(ml[rng.below(ml.size())]) == ActionResult::Ok);
+        }
+    }
+
+    // worlds drawn from beliefs keep the observer and stay in the support
+    const GameState s = parse_position("Ba3/Ge5/Ju2/Go4 0 0");
+    coup_sim::CoinBeliefs cb;
+    cb[0] = coup_sim::CoinDist::exact(3);
+    cb[1] = coup_sim::CoinDist::uniform({2, 8});
+    cb[2] = coup_sim::CoinDist::uniform({0, 4});
+    cb[3] = coup_sim::CoinDist::exact(4);
+    Rng rng(5);
+    for (int i = 0; i < 50; ++i) {
+        const GameState w = coup_sim::determinize(s, cb, 0, rng);
+        CHECK(w.coins[0] == 3);
+        for (std::size_t t = 1; t < 4; ++t) CHECK(cb[t][w.coins[t]] > 0.0f);
+    }
+    coup_sim::IsmctsConfig ic;
+    ic.worlds            = 4;
+    ic.search.iterations = 100;
+    coup_sim::IsmctsBot one(ic);
+    ic.threads = 2;
+    coup_sim::IsmctsBot two(ic);
+    CHECK(one.choose(s, cb) == two.choose(s, cb));
+
+    // the simulator tracks each seat over the whole log
+    coup_sim::SimConfig sc;
+    sc.games                    = 2;
+    sc.players                  = 4;
+    sc.policy                   = coup_sim::PolicyKind::Ismcts;
+    sc.ismcts.worlds            = 2;
+    sc.ismcts.search.iterations = 20;
+    const coup_sim::SimStats st = coup_sim::Simulator(sc).run();
+    CHECK(st.illegal == 0);
+    CHECK(st.decisions > 0);
+    CHECK(coup_sim::Simulator(sc).run().turns == st.turns);
+}